@@ -0,0 +1,13 @@
+#ifndef CLOCK_ALTREP_H
+#define CLOCK_ALTREP_H
+
+#include "clock.h"
+
+// Older versions of `Altrep.h` use `class` as a parameter name
+#define class klass
+extern "C" {
+#include <R_ext/Altrep.h>
+}
+#undef class
+
+#endif
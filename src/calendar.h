@@ -4,6 +4,8 @@
 #include "clock.h"
 #include "enums.h"
 #include "integers.h"
+#include "duration.h"
+#include <algorithm>
 
 // -----------------------------------------------------------------------------
 
@@ -95,16 +97,45 @@ cpp11::writable::list
 as_sys_time_from_calendar_impl(const Calendar& x) {
   using Duration = typename ClockDuration::chrono_duration;
 
+  using rclock::duration::block_size;
+  using rclock::duration::block_na;
+
   const r_ssize size = x.size();
   ClockDuration out(size);
 
-  for (r_ssize i = 0; i < size; ++i) {
-    if (x.is_na(i)) {
-      out.assign_na(i);
-    } else {
-      date::sys_time<Duration> elt_st = x.to_sys_time(i);
-      Duration elt = elt_st.time_since_epoch();
-      out.assign(elt, i);
+  // Written out a block at a time, see `get_block()`
+  int64_t block[block_size];
+
+  for (r_ssize start = 0; start < size; start += block_size) {
+    const r_ssize n = std::min(block_size, size - start);
+
+    bool has_min = false;
+
+    for (r_ssize k = 0; k < n; ++k) {
+      const r_ssize i = start + k;
+
+      if (x.is_na(i)) {
+        block[k] = block_na;
+      } else {
+        date::sys_time<Duration> elt_st = x.to_sys_time(i);
+        Duration elt = elt_st.time_since_epoch();
+        block[k] = static_cast<int64_t>(elt.count());
+        has_min |= block[k] == block_na;
+      }
+    }
+
+    out.assign_block(block, start, n);
+
+    if (has_min) {
+      // Non-missing values that `assign_block()` took as missing
+      for (r_ssize k = 0; k < n; ++k) {
+        const r_ssize i = start + k;
+
+        if (block[k] == block_na && !x.is_na(i)) {
+          const date::sys_time<Duration> elt_st = x.to_sys_time(i);
+          out.assign(elt_st.time_since_epoch(), i);
+        }
+      }
     }
   }
 
@@ -116,22 +147,122 @@ cpp11::writable::list
 as_calendar_from_sys_time_impl(cpp11::list_of<cpp11::doubles>& fields) {
   using Duration = typename ClockDuration::chrono_duration;
 
+  using Rep = typename Duration::rep;
+  using rclock::duration::block_size;
+  using rclock::duration::block_na;
+
   const ClockDuration x{fields};
   const r_ssize size = x.size();
 
   Calendar out(size);
 
-  for (r_ssize i = 0; i < size; ++i) {
-    if (x.is_na(i)) {
-      out.assign_na(i);
-    } else {
-      Duration elt = x[i];
-      date::sys_time<Duration> elt_st{elt};
-      out.assign_sys_time(elt_st, i);
+  // Read a block at a time, see `get_block()`
+  int64_t block[block_size];
+
+  for (r_ssize start = 0; start < size; start += block_size) {
+    const r_ssize n = std::min(block_size, size - start);
+
+    const bool has_min = x.get_block(block, start, n);
+
+    for (r_ssize k = 0; k < n; ++k) {
+      const r_ssize i = start + k;
+
+      if (block[k] == block_na && (!has_min || x.is_na(i))) {
+        out.assign_na(i);
+      } else {
+        Duration elt{static_cast<Rep>(block[k])};
+        date::sys_time<Duration> elt_st{elt};
+        out.assign_sys_time(elt_st, i);
+      }
     }
   }
 
   return out.to_list();
 }
 
+// -----------------------------------------------------------------------------
+
+/*
+ * A single year-month-day component of a time point, computed straight from
+ * its count rather than through a full calendar. The subsecond components
+ * return the subsecond count in units of `Duration`, so callers must only ask
+ * for the one matching the precision.
+ *
+ * Also used from ALTREP methods, which aren't run with unwind protection, so
+ * no `clock_abort()`.
+ */
+template <class Duration>
+static
+inline
+int
+get_ymd_component_one(const Duration& x, const enum component& component_val) {
+  const date::days days = date::floor<date::days>(x);
+
+  switch (component_val) {
+  case component::year: {
+    const date::year_month_day ymd{date::sys_days{days}};
+    return static_cast<int>(ymd.year());
+  }
+  case component::month: {
+    const date::year_month_day ymd{date::sys_days{days}};
+    return static_cast<int>(static_cast<unsigned>(ymd.month()));
+  }
+  case component::day: {
+    const date::year_month_day ymd{date::sys_days{days}};
+    return static_cast<int>(static_cast<unsigned>(ymd.day()));
+  }
+  default: {
+    break;
+  }
+  }
+
+  const Duration tod = x - days;
+
+  switch (component_val) {
+  case component::hour: {
+    return static_cast<int>(date::floor<std::chrono::hours>(tod).count());
+  }
+  case component::minute: {
+    return static_cast<int>(date::floor<std::chrono::minutes>(tod).count() % 60);
+  }
+  case component::second: {
+    return static_cast<int>(date::floor<std::chrono::seconds>(tod).count() % 60);
+  }
+  case component::millisecond:
+  case component::microsecond:
+  case component::nanosecond: {
+    return static_cast<int>((tod - date::floor<std::chrono::seconds>(tod)).count());
+  }
+  default: {
+    Rf_error("Internal error: Reached the unreachable in `get_ymd_component_one()`.");
+  }
+  }
+}
+
+/*
+ * Fills `p_out` with one year-month-day component of each element of a block
+ * of counts of `Duration`, see `get_block()`. This is the fused form of
+ * `as_calendar_from_sys_time_impl()` followed by a getter, and only ever
+ * touches the one output vector.
+ */
+template <class Duration>
+static
+inline
+void
+get_ymd_component_block(const int64_t* p_x,
+                        const r_ssize& size,
+                        const enum component& component_val,
+                        int* p_out) {
+  using Rep = typename Duration::rep;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (p_x[i] == rclock::duration::block_na) {
+      p_out[i] = r_int_na;
+    } else {
+      const Duration elt{static_cast<Rep>(p_x[i])};
+      p_out[i] = get_ymd_component_one(elt, component_val);
+    }
+  }
+}
+
 #endif
@@ -194,6 +194,13 @@ extern "C" SEXP _clock_duration_maximum_cpp(SEXP precision_int) {
     return cpp11::as_sexp(duration_maximum_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int)));
   END_CPP11
 }
+// duration.cpp
+cpp11::writable::integers duration_proxy_order_cpp(cpp11::list_of<cpp11::doubles> fields);
+extern "C" SEXP _clock_duration_proxy_order_cpp(SEXP fields) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(duration_proxy_order_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields)));
+  END_CPP11
+}
 // enums.cpp
 cpp11::writable::strings precision_to_string(const cpp11::integers& precision_int);
 extern "C" SEXP _clock_precision_to_string(SEXP precision_int) {
@@ -306,6 +313,19 @@ extern "C" SEXP _clock_year_day_minus_year_day_cpp(SEXP x, SEXP y, SEXP precisio
     return cpp11::as_sexp(year_day_minus_year_day_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::integers>>>(x), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::integers>>>(y), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int)));
   END_CPP11
 }
+// gregorian-year-month-day-lazy.cpp
+cpp11::writable::list as_year_month_day_from_sys_time_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int);
+extern "C" SEXP _clock_as_year_month_day_from_sys_time_cpp(SEXP fields, SEXP precision_int) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(as_year_month_day_from_sys_time_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int)));
+  END_CPP11
+}
+cpp11::writable::integers ymd_field_get_region_cpp(SEXP x, double start, double size, bool materialize);
+extern "C" SEXP _clock_ymd_field_get_region_cpp(SEXP x, SEXP start, SEXP size, SEXP materialize) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(ymd_field_get_region_cpp(cpp11::as_cpp<cpp11::decay_t<SEXP>>(x), cpp11::as_cpp<cpp11::decay_t<double>>(start), cpp11::as_cpp<cpp11::decay_t<double>>(size), cpp11::as_cpp<cpp11::decay_t<bool>>(materialize)));
+  END_CPP11
+}
 // gregorian-year-month-day.cpp
 SEXP new_year_month_day_from_fields(SEXP fields, const cpp11::integers& precision_int, SEXP names);
 extern "C" SEXP _clock_new_year_month_day_from_fields(SEXP fields, SEXP precision_int, SEXP names) {
@@ -384,13 +404,6 @@ extern "C" SEXP _clock_as_sys_time_year_month_day_cpp(SEXP fields, SEXP precisio
   END_CPP11
 }
 // gregorian-year-month-day.cpp
-cpp11::writable::list as_year_month_day_from_sys_time_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int);
-extern "C" SEXP _clock_as_year_month_day_from_sys_time_cpp(SEXP fields, SEXP precision_int) {
-  BEGIN_CPP11
-    return cpp11::as_sexp(as_year_month_day_from_sys_time_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int)));
-  END_CPP11
-}
-// gregorian-year-month-day.cpp
 cpp11::writable::list year_month_day_minus_year_month_day_cpp(cpp11::list_of<cpp11::integers> x, cpp11::list_of<cpp11::integers> y, const cpp11::integers& precision_int);
 extern "C" SEXP _clock_year_month_day_minus_year_month_day_cpp(SEXP x, SEXP y, SEXP precision_int) {
   BEGIN_CPP11
@@ -608,10 +621,10 @@ extern "C" SEXP _clock_clock_get_calendar_year_minimum() {
   END_CPP11
 }
 // naive-time.cpp
-cpp11::writable::list naive_time_info_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone);
-extern "C" SEXP _clock_naive_time_info_cpp(SEXP fields, SEXP precision_int, SEXP zone) {
+cpp11::writable::list naive_time_info_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::logicals& columns);
+extern "C" SEXP _clock_naive_time_info_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP columns) {
   BEGIN_CPP11
-    return cpp11::as_sexp(naive_time_info_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
+    return cpp11::as_sexp(naive_time_info_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::logicals&>>(columns)));
   END_CPP11
 }
 // quarterly-year-quarter-day.cpp
@@ -720,6 +733,13 @@ extern "C" SEXP _clock_clock_rcrd_proxy(SEXP x) {
   END_CPP11
 }
 // rcrd.cpp
+cpp11::writable::integers calendar_pack_cpp(cpp11::list_of<cpp11::integers> fields, const cpp11::integers& multipliers);
+extern "C" SEXP _clock_calendar_pack_cpp(SEXP fields, SEXP multipliers) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(calendar_pack_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::integers>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(multipliers)));
+  END_CPP11
+}
+// rcrd.cpp
 SEXP clock_rcrd_names(SEXP x);
 extern "C" SEXP _clock_clock_rcrd_names(SEXP x) {
   BEGIN_CPP11
@@ -741,10 +761,10 @@ extern "C" SEXP _clock_sys_time_now_cpp() {
   END_CPP11
 }
 // sys-time.cpp
-cpp11::writable::list sys_time_info_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone);
-extern "C" SEXP _clock_sys_time_info_cpp(SEXP fields, SEXP precision_int, SEXP zone) {
+cpp11::writable::list sys_time_info_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::logicals& columns);
+extern "C" SEXP _clock_sys_time_info_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP columns) {
   BEGIN_CPP11
-    return cpp11::as_sexp(sys_time_info_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone)));
+    return cpp11::as_sexp(sys_time_info_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::logicals&>>(columns)));
   END_CPP11
 }
 // time-point.cpp
@@ -902,6 +922,35 @@ extern "C" SEXP _clock_zone_is_valid(SEXP zone) {
   END_CPP11
 }
 // zone.cpp
+cpp11::writable::list zone_transitions_cpp(const cpp11::strings& zone, cpp11::list_of<cpp11::doubles> from, cpp11::list_of<cpp11::doubles> to);
+extern "C" SEXP _clock_zone_transitions_cpp(SEXP zone, SEXP from, SEXP to) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zone_transitions_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(from), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(to)));
+  END_CPP11
+}
+// zone.cpp
+cpp11::writable::strings zone_preload_cpp(const cpp11::strings& zones);
+extern "C" SEXP _clock_zone_preload_cpp(SEXP zones) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zone_preload_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zones)));
+  END_CPP11
+}
+// zone.cpp
+cpp11::writable::strings zone_cache_read_cpp(const cpp11::strings& path, const cpp11::strings& version);
+extern "C" SEXP _clock_zone_cache_read_cpp(SEXP path, SEXP version) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zone_cache_read_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(path), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(version)));
+  END_CPP11
+}
+// zone.cpp
+void zone_cache_write_cpp(const cpp11::strings& path, const cpp11::strings& zones, const cpp11::strings& version);
+extern "C" SEXP _clock_zone_cache_write_cpp(SEXP path, SEXP zones, SEXP version) {
+  BEGIN_CPP11
+    zone_cache_write_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(path), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zones), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(version));
+    return R_NilValue;
+  END_CPP11
+}
+// zone.cpp
 cpp11::writable::strings zone_current();
 extern "C" SEXP _clock_zone_current() {
   BEGIN_CPP11
@@ -930,6 +979,41 @@ extern "C" SEXP _clock_get_naive_time_cpp(SEXP fields, SEXP precision_int, SEXP
   END_CPP11
 }
 // zoned-time.cpp
+cpp11::writable::list zoned_time_floor_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::integers& precision_to_int, const int& n, cpp11::list_of<cpp11::doubles> origin_fields, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, cpp11::list_of<cpp11::doubles> reference_fields, const cpp11::sexp& call);
+extern "C" SEXP _clock_zoned_time_floor_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP precision_to_int, SEXP n, SEXP origin_fields, SEXP nonexistent_string, SEXP ambiguous_string, SEXP reference_fields, SEXP call) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zoned_time_floor_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_to_int), cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(origin_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(nonexistent_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(ambiguous_string), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(reference_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::sexp&>>(call)));
+  END_CPP11
+}
+// zoned-time.cpp
+cpp11::writable::list zoned_time_ceiling_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::integers& precision_to_int, const int& n, cpp11::list_of<cpp11::doubles> origin_fields, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, cpp11::list_of<cpp11::doubles> reference_fields, const cpp11::sexp& call);
+extern "C" SEXP _clock_zoned_time_ceiling_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP precision_to_int, SEXP n, SEXP origin_fields, SEXP nonexistent_string, SEXP ambiguous_string, SEXP reference_fields, SEXP call) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zoned_time_ceiling_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_to_int), cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(origin_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(nonexistent_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(ambiguous_string), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(reference_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::sexp&>>(call)));
+  END_CPP11
+}
+// zoned-time.cpp
+cpp11::writable::list zoned_time_round_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::integers& precision_to_int, const int& n, cpp11::list_of<cpp11::doubles> origin_fields, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, cpp11::list_of<cpp11::doubles> reference_fields, const cpp11::sexp& call);
+extern "C" SEXP _clock_zoned_time_round_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP precision_to_int, SEXP n, SEXP origin_fields, SEXP nonexistent_string, SEXP ambiguous_string, SEXP reference_fields, SEXP call) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zoned_time_round_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_to_int), cpp11::as_cpp<cpp11::decay_t<const int&>>(n), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(origin_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(nonexistent_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(ambiguous_string), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(reference_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::sexp&>>(call)));
+  END_CPP11
+}
+// zoned-time.cpp
+cpp11::writable::list zoned_time_plus_local_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, cpp11::list_of<cpp11::doubles> n_fields, const cpp11::integers& precision_n_int, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, cpp11::list_of<cpp11::doubles> reference_fields, const cpp11::sexp& call);
+extern "C" SEXP _clock_zoned_time_plus_local_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP n_fields, SEXP precision_n_int, SEXP nonexistent_string, SEXP ambiguous_string, SEXP reference_fields, SEXP call) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zoned_time_plus_local_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(n_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_n_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(nonexistent_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(ambiguous_string), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(reference_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::sexp&>>(call)));
+  END_CPP11
+}
+// zoned-time.cpp
+cpp11::writable::list zoned_time_set_local_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::integers& value, const cpp11::strings& component, const bool& last, const cpp11::strings& invalid_string, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, cpp11::list_of<cpp11::doubles> reference_fields, const cpp11::sexp& call);
+extern "C" SEXP _clock_zoned_time_set_local_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP value, SEXP component, SEXP last, SEXP invalid_string, SEXP nonexistent_string, SEXP ambiguous_string, SEXP reference_fields, SEXP call) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(zoned_time_set_local_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(value), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(component), cpp11::as_cpp<cpp11::decay_t<const bool&>>(last), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(invalid_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(nonexistent_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(ambiguous_string), cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(reference_fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::sexp&>>(call)));
+  END_CPP11
+}
+// zoned-time.cpp
 cpp11::writable::list as_zoned_sys_time_from_naive_time_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, const cpp11::sexp& call);
 extern "C" SEXP _clock_as_zoned_sys_time_from_naive_time_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP nonexistent_string, SEXP ambiguous_string, SEXP call) {
   BEGIN_CPP11
@@ -944,6 +1028,13 @@ extern "C" SEXP _clock_as_zoned_sys_time_from_naive_time_with_reference_cpp(SEXP
   END_CPP11
 }
 // zoned-time.cpp
+cpp11::writable::list as_sys_time_from_naive_time_zones_cpp(cpp11::list_of<cpp11::doubles> fields, const cpp11::integers& precision_int, const cpp11::strings& zone, const cpp11::strings& nonexistent_string, const cpp11::strings& ambiguous_string, const cpp11::sexp& call);
+extern "C" SEXP _clock_as_sys_time_from_naive_time_zones_cpp(SEXP fields, SEXP precision_int, SEXP zone, SEXP nonexistent_string, SEXP ambiguous_string, SEXP call) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(as_sys_time_from_naive_time_zones_cpp(cpp11::as_cpp<cpp11::decay_t<cpp11::list_of<cpp11::doubles>>>(fields), cpp11::as_cpp<cpp11::decay_t<const cpp11::integers&>>(precision_int), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(nonexistent_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(ambiguous_string), cpp11::as_cpp<cpp11::decay_t<const cpp11::sexp&>>(call)));
+  END_CPP11
+}
+// zoned-time.cpp
 cpp11::writable::list to_sys_duration_fields_from_sys_seconds_cpp(const cpp11::doubles& seconds);
 extern "C" SEXP _clock_to_sys_duration_fields_from_sys_seconds_cpp(SEXP seconds) {
   BEGIN_CPP11
@@ -958,6 +1049,13 @@ extern "C" SEXP _clock_to_sys_seconds_from_sys_duration_fields_cpp(SEXP fields)
   END_CPP11
 }
 // zoned-time.cpp
+cpp11::writable::integers get_posixt_component_cpp(const cpp11::doubles& x, const cpp11::strings& zone, const cpp11::strings& component);
+extern "C" SEXP _clock_get_posixt_component_cpp(SEXP x, SEXP zone, SEXP component) {
+  BEGIN_CPP11
+    return cpp11::as_sexp(get_posixt_component_cpp(cpp11::as_cpp<cpp11::decay_t<const cpp11::doubles&>>(x), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(zone), cpp11::as_cpp<cpp11::decay_t<const cpp11::strings&>>(component)));
+  END_CPP11
+}
+// zoned-time.cpp
 cpp11::writable::list zoned_time_parse_complete_cpp(const cpp11::strings& x, const cpp11::strings& format, const cpp11::integers& precision_int, const cpp11::strings& month, const cpp11::strings& month_abbrev, const cpp11::strings& weekday, const cpp11::strings& weekday_abbrev, const cpp11::strings& am_pm, const cpp11::strings& mark);
 extern "C" SEXP _clock_zoned_time_parse_complete_cpp(SEXP x, SEXP format, SEXP precision_int, SEXP month, SEXP month_abbrev, SEXP weekday, SEXP weekday_abbrev, SEXP am_pm, SEXP mark) {
   BEGIN_CPP11
@@ -975,6 +1073,7 @@ extern "C" SEXP _clock_zoned_time_parse_abbrev_cpp(SEXP x, SEXP zone, SEXP forma
 extern "C" {
 static const R_CallMethodDef CallEntries[] = {
     {"_clock_as_iso_year_week_day_from_sys_time_cpp",               (DL_FUNC) &_clock_as_iso_year_week_day_from_sys_time_cpp,                2},
+    {"_clock_as_sys_time_from_naive_time_zones_cpp",                (DL_FUNC) &_clock_as_sys_time_from_naive_time_zones_cpp,                 6},
     {"_clock_as_sys_time_iso_year_week_day_cpp",                    (DL_FUNC) &_clock_as_sys_time_iso_year_week_day_cpp,                     2},
     {"_clock_as_sys_time_year_day_cpp",                             (DL_FUNC) &_clock_as_sys_time_year_day_cpp,                              2},
     {"_clock_as_sys_time_year_month_day_cpp",                       (DL_FUNC) &_clock_as_sys_time_year_month_day_cpp,                        2},
@@ -988,6 +1087,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_clock_as_year_week_day_from_sys_time_cpp",                   (DL_FUNC) &_clock_as_year_week_day_from_sys_time_cpp,                    3},
     {"_clock_as_zoned_sys_time_from_naive_time_cpp",                (DL_FUNC) &_clock_as_zoned_sys_time_from_naive_time_cpp,                 6},
     {"_clock_as_zoned_sys_time_from_naive_time_with_reference_cpp", (DL_FUNC) &_clock_as_zoned_sys_time_from_naive_time_with_reference_cpp,  7},
+    {"_clock_calendar_pack_cpp",                                    (DL_FUNC) &_clock_calendar_pack_cpp,                                     2},
     {"_clock_clock_get_calendar_year_maximum",                      (DL_FUNC) &_clock_clock_get_calendar_year_maximum,                       0},
     {"_clock_clock_get_calendar_year_minimum",                      (DL_FUNC) &_clock_clock_get_calendar_year_minimum,                       0},
     {"_clock_clock_init_utils",                                     (DL_FUNC) &_clock_clock_init_utils,                                      0},
@@ -1010,6 +1110,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_clock_duration_modulus_cpp",                                 (DL_FUNC) &_clock_duration_modulus_cpp,                                  3},
     {"_clock_duration_plus_cpp",                                    (DL_FUNC) &_clock_duration_plus_cpp,                                     3},
     {"_clock_duration_precision_common_cpp",                        (DL_FUNC) &_clock_duration_precision_common_cpp,                         2},
+    {"_clock_duration_proxy_order_cpp",                             (DL_FUNC) &_clock_duration_proxy_order_cpp,                              1},
     {"_clock_duration_restore",                                     (DL_FUNC) &_clock_duration_restore,                                      2},
     {"_clock_duration_round_cpp",                                   (DL_FUNC) &_clock_duration_round_cpp,                                    4},
     {"_clock_duration_scalar_divide_cpp",                           (DL_FUNC) &_clock_duration_scalar_divide_cpp,                            3},
@@ -1032,6 +1133,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_clock_format_zoned_time_cpp",                                (DL_FUNC) &_clock_format_zoned_time_cpp,                                11},
     {"_clock_get_iso_year_week_day_last_cpp",                       (DL_FUNC) &_clock_get_iso_year_week_day_last_cpp,                        1},
     {"_clock_get_naive_time_cpp",                                   (DL_FUNC) &_clock_get_naive_time_cpp,                                    3},
+    {"_clock_get_posixt_component_cpp",                             (DL_FUNC) &_clock_get_posixt_component_cpp,                              3},
     {"_clock_get_year_day_last_cpp",                                (DL_FUNC) &_clock_get_year_day_last_cpp,                                 1},
     {"_clock_get_year_month_day_last_cpp",                          (DL_FUNC) &_clock_get_year_month_day_last_cpp,                           2},
     {"_clock_get_year_month_weekday_last_cpp",                      (DL_FUNC) &_clock_get_year_month_weekday_last_cpp,                       4},
@@ -1066,7 +1168,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_clock_iso_year_week_day_minus_iso_year_week_day_cpp",        (DL_FUNC) &_clock_iso_year_week_day_minus_iso_year_week_day_cpp,         3},
     {"_clock_iso_year_week_day_plus_years_cpp",                     (DL_FUNC) &_clock_iso_year_week_day_plus_years_cpp,                      2},
     {"_clock_iso_year_week_day_restore",                            (DL_FUNC) &_clock_iso_year_week_day_restore,                             2},
-    {"_clock_naive_time_info_cpp",                                  (DL_FUNC) &_clock_naive_time_info_cpp,                                   3},
+    {"_clock_naive_time_info_cpp",                                  (DL_FUNC) &_clock_naive_time_info_cpp,                                   4},
     {"_clock_new_duration_from_fields",                             (DL_FUNC) &_clock_new_duration_from_fields,                              3},
     {"_clock_new_iso_year_week_day_from_fields",                    (DL_FUNC) &_clock_new_iso_year_week_day_from_fields,                     3},
     {"_clock_new_time_point_from_fields",                           (DL_FUNC) &_clock_new_time_point_from_fields,                            4},
@@ -1077,7 +1179,7 @@ static const R_CallMethodDef CallEntries[] = {
     {"_clock_new_year_week_day_from_fields",                        (DL_FUNC) &_clock_new_year_week_day_from_fields,                         4},
     {"_clock_new_zoned_time_from_fields",                           (DL_FUNC) &_clock_new_zoned_time_from_fields,                            4},
     {"_clock_precision_to_string",                                  (DL_FUNC) &_clock_precision_to_string,                                   1},
-    {"_clock_sys_time_info_cpp",                                    (DL_FUNC) &_clock_sys_time_info_cpp,                                     3},
+    {"_clock_sys_time_info_cpp",                                    (DL_FUNC) &_clock_sys_time_info_cpp,                                     4},
     {"_clock_sys_time_now_cpp",                                     (DL_FUNC) &_clock_sys_time_now_cpp,                                      0},
     {"_clock_time_point_parse_cpp",                                 (DL_FUNC) &_clock_time_point_parse_cpp,                                 10},
     {"_clock_time_point_restore",                                   (DL_FUNC) &_clock_time_point_restore,                                    2},
@@ -1107,17 +1209,32 @@ static const R_CallMethodDef CallEntries[] = {
     {"_clock_year_week_day_minus_year_week_day_cpp",                (DL_FUNC) &_clock_year_week_day_minus_year_week_day_cpp,                 4},
     {"_clock_year_week_day_plus_years_cpp",                         (DL_FUNC) &_clock_year_week_day_plus_years_cpp,                          3},
     {"_clock_year_week_day_restore",                                (DL_FUNC) &_clock_year_week_day_restore,                                 2},
+    {"_clock_ymd_field_get_region_cpp",                             (DL_FUNC) &_clock_ymd_field_get_region_cpp,                              4},
+    {"_clock_zone_cache_read_cpp",                                  (DL_FUNC) &_clock_zone_cache_read_cpp,                                   2},
+    {"_clock_zone_cache_write_cpp",                                 (DL_FUNC) &_clock_zone_cache_write_cpp,                                  3},
     {"_clock_zone_current",                                         (DL_FUNC) &_clock_zone_current,                                          0},
     {"_clock_zone_is_valid",                                        (DL_FUNC) &_clock_zone_is_valid,                                         1},
+    {"_clock_zone_preload_cpp",                                     (DL_FUNC) &_clock_zone_preload_cpp,                                      1},
+    {"_clock_zone_transitions_cpp",                                 (DL_FUNC) &_clock_zone_transitions_cpp,                                  3},
+    {"_clock_zoned_time_ceiling_cpp",                               (DL_FUNC) &_clock_zoned_time_ceiling_cpp,                               10},
+    {"_clock_zoned_time_floor_cpp",                                 (DL_FUNC) &_clock_zoned_time_floor_cpp,                                 10},
     {"_clock_zoned_time_parse_abbrev_cpp",                          (DL_FUNC) &_clock_zoned_time_parse_abbrev_cpp,                          10},
     {"_clock_zoned_time_parse_complete_cpp",                        (DL_FUNC) &_clock_zoned_time_parse_complete_cpp,                         9},
+    {"_clock_zoned_time_plus_local_cpp",                            (DL_FUNC) &_clock_zoned_time_plus_local_cpp,                             9},
     {"_clock_zoned_time_restore",                                   (DL_FUNC) &_clock_zoned_time_restore,                                    2},
+    {"_clock_zoned_time_round_cpp",                                 (DL_FUNC) &_clock_zoned_time_round_cpp,                                 10},
+    {"_clock_zoned_time_set_local_cpp",                             (DL_FUNC) &_clock_zoned_time_set_local_cpp,                             11},
     {NULL, NULL, 0}
 };
 }
 
+void clock_init_duration_seq(DllInfo* dll);
+void clock_init_year_month_day_lazy(DllInfo* dll);
+
 extern "C" attribute_visible void R_init_clock(DllInfo* dll){
   R_registerRoutines(dll, NULL, CallEntries, NULL, NULL);
   R_useDynamicSymbols(dll, FALSE);
+  clock_init_duration_seq(dll);
+  clock_init_year_month_day_lazy(dll);
   R_forceSymbols(dll, TRUE);
 }
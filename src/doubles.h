@@ -5,17 +5,24 @@
 
 namespace rclock {
 
+/*
+ * The `double` counterpart of `rclock::integers`, see `integers.h`
+ */
 class doubles
 {
   const cpp11::doubles read_;
   cpp11::writable::doubles write_;
   bool writable_;
   r_ssize size_;
+  const double* p_read_;
+  double* p_write_;
 
 public:
   doubles() noexcept;
   doubles(const cpp11::doubles& x);
   doubles(r_ssize size);
+  doubles(const doubles& x);
+  doubles(doubles&& x);
 
   bool is_na(r_ssize i) const noexcept;
   r_ssize size() const noexcept;
@@ -25,7 +32,14 @@ public:
 
   double operator[](r_ssize i) const noexcept;
 
+  const double* data() const noexcept;
+  double* data_writable();
+
   SEXP sexp() const noexcept;
+
+private:
+  void init_pointers();
+  void make_writable();
 };
 
 namespace detail {
@@ -38,28 +52,77 @@ inline
 doubles::doubles() noexcept
   : read_(detail::empty_doubles),
     writable_(false),
-    size_(0)
+    size_(0),
+    p_read_(NULL),
+    p_write_(NULL)
   {}
 
 inline
 doubles::doubles(const cpp11::doubles& x)
   : read_(x),
     writable_(false),
-    size_(x.size())
-  {}
+    size_(x.size()),
+    p_read_(NULL),
+    p_write_(NULL) {
+  init_pointers();
+}
 
 inline
 doubles::doubles(r_ssize size)
   : read_(detail::empty_doubles),
     write_(cpp11::writable::doubles(size)),
     writable_(true),
-    size_(size)
+    size_(size),
+    p_read_(NULL),
+    p_write_(NULL) {
+  init_pointers();
+}
+
+inline
+doubles::doubles(const doubles& x)
+  : read_(x.read_),
+    write_(x.write_),
+    writable_(x.writable_),
+    size_(x.size_),
+    p_read_(NULL),
+    p_write_(NULL) {
+  init_pointers();
+}
+
+inline
+doubles::doubles(doubles&& x)
+  : read_(x.read_),
+    write_(std::move(x.write_)),
+    writable_(x.writable_),
+    size_(x.size_),
+    p_read_(x.p_read_),
+    p_write_(x.p_write_)
   {}
 
+inline
+void
+doubles::init_pointers() {
+  if (writable_) {
+    p_write_ = REAL(write_);
+    p_read_ = p_write_;
+  } else if (size_ > 0) {
+    p_read_ = REAL_RO(read_);
+  }
+}
+
+// Always copies, see `integers::make_writable()`
+inline
+void
+doubles::make_writable() {
+  write_ = cpp11::writable::doubles(read_);
+  writable_ = true;
+  init_pointers();
+}
+
 inline
 bool
 doubles::is_na(r_ssize i) const noexcept {
-  return std::isnan(this->operator[](i));
+  return std::isnan(p_read_[i]);
 }
 
 inline
@@ -72,10 +135,9 @@ inline
 void
 doubles::assign(double x, r_ssize i) {
   if (!writable_) {
-    write_ = cpp11::writable::doubles(read_);
-    writable_ = true;
+    make_writable();
   }
-  write_[i] = x;
+  p_write_[i] = x;
 }
 
 inline
@@ -87,7 +149,26 @@ doubles::assign_na(r_ssize i) {
 inline
 double
 doubles::operator[](r_ssize i) const noexcept {
-  return writable_ ? write_[i] : read_[i];
+  return p_read_[i];
+}
+
+/*
+ * Raw access for kernels that work on whole blocks of elements at once.
+ * `data_writable()` makes the same lazy copy as `assign()`.
+ */
+inline
+const double*
+doubles::data() const noexcept {
+  return p_read_;
+}
+
+inline
+double*
+doubles::data_writable() {
+  if (!writable_) {
+    make_writable();
+  }
+  return p_write_;
 }
 
 inline
@@ -4,10 +4,13 @@
 #include "enums.h"
 #include "get.h"
 #include "rcrd.h"
+#include "altrep.h"
 #include <sstream>
 #include <cfloat>
 #include <algorithm>
 #include <limits>
+#include <cstring>
+#include <vector>
 
 // -----------------------------------------------------------------------------
 
@@ -259,6 +262,78 @@ enum class arith_op {
   modulus
 };
 
+/*
+ * `+` and `-` work on blocks of packed values rather than element by element,
+ * see `get_block()`. The arithmetic is done on `uint64_t`, which wraps on
+ * overflow rather than being undefined, and missing values are propagated with
+ * a select, so the inner loops are branch free and can be vectorized.
+ *
+ * The rare block where `block_na` is also a non-missing input or result, see
+ * `block_na`, is redone one element at a time.
+ */
+template <class ClockDuration>
+static
+inline
+void
+duration_arith_block(const ClockDuration& x,
+                     const ClockDuration& y,
+                     ClockDuration& out,
+                     const enum arith_op& op) {
+  using Duration = typename ClockDuration::chrono_duration;
+  using Rep = typename Duration::rep;
+  using rclock::duration::block_size;
+  using rclock::duration::block_na;
+
+  int64_t x_block[block_size];
+  int64_t y_block[block_size];
+  int64_t out_block[block_size];
+
+  const r_ssize size = x.size();
+
+  for (r_ssize start = 0; start < size; start += block_size) {
+    const r_ssize n = std::min(block_size, size - start);
+
+    bool has_min = x.get_block(x_block, start, n);
+    has_min |= y.get_block(y_block, start, n);
+
+    if (op == arith_op::plus) {
+      for (r_ssize k = 0; k < n; ++k) {
+        const uint64_t elt = static_cast<uint64_t>(x_block[k]) + static_cast<uint64_t>(y_block[k]);
+        const bool na = (x_block[k] == block_na) | (y_block[k] == block_na);
+        out_block[k] = na ? block_na : static_cast<int64_t>(elt);
+        has_min |= !na & (static_cast<int64_t>(elt) == block_na);
+      }
+    } else {
+      for (r_ssize k = 0; k < n; ++k) {
+        const uint64_t elt = static_cast<uint64_t>(x_block[k]) - static_cast<uint64_t>(y_block[k]);
+        const bool na = (x_block[k] == block_na) | (y_block[k] == block_na);
+        out_block[k] = na ? block_na : static_cast<int64_t>(elt);
+        has_min |= !na & (static_cast<int64_t>(elt) == block_na);
+      }
+    }
+
+    if (!has_min) {
+      out.assign_block(out_block, start, n);
+      continue;
+    }
+
+    for (r_ssize k = 0; k < n; ++k) {
+      const r_ssize i = start + k;
+
+      if (x.is_na(i) || y.is_na(i)) {
+        out.assign_na(i);
+        continue;
+      }
+
+      const uint64_t elt = op == arith_op::plus ?
+        static_cast<uint64_t>(x_block[k]) + static_cast<uint64_t>(y_block[k]) :
+        static_cast<uint64_t>(x_block[k]) - static_cast<uint64_t>(y_block[k]);
+
+      out.assign(Duration{static_cast<Rep>(static_cast<int64_t>(elt))}, i);
+    }
+  }
+}
+
 template <class ClockDuration>
 static
 inline
@@ -273,24 +348,9 @@ duration_arith_impl(cpp11::list_of<cpp11::doubles>& x_fields,
   ClockDuration out(size);
 
   switch (op) {
-  case arith_op::plus: {
-    for (r_ssize i = 0; i < size; ++i) {
-      if (x.is_na(i) || y.is_na(i)) {
-        out.assign_na(i);
-        continue;
-      }
-      out.assign(x[i] + y[i], i);
-    }
-    break;
-  }
+  case arith_op::plus:
   case arith_op::minus: {
-    for (r_ssize i = 0; i < size; ++i) {
-      if (x.is_na(i) || y.is_na(i)) {
-        out.assign_na(i);
-        continue;
-      }
-      out.assign(x[i] - y[i], i);
-    }
+    duration_arith_block(x, y, out, op);
     break;
   }
   case arith_op::modulus: {
@@ -1281,6 +1341,396 @@ duration_sign_cpp(cpp11::list_of<cpp11::doubles> fields,
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Compact duration sequences
+ *
+ * Regular sequences of durations (and the time points and dates built on them)
+ * are fully described by `from`, `by`, and their size, so their `lower` and
+ * `upper` fields are returned as ALTREP doubles that compute elements on
+ * demand, like R's own compact integer sequences. Minute resolution grids over
+ * many years are hundreds of millions of elements long, and are usually only
+ * sliced.
+ *
+ * - `Elt()`, `Get_region()`, and `Extract_subset()` compute only the requested
+ *   elements. `Extract_subset()` is also what vctrs uses to slice ALTREP
+ *   vectors, so `vec_slice()` never materializes the sequence.
+ * - `Is_sorted()` and `Sum()` are answered from `from` and `by` where
+ *   possible, and otherwise fall back to R's defaults.
+ * - Anything needing a data pointer materializes the field once.
+ *
+ * `data1` is a raw vector holding a `duration_seq_info`, and `data2` is the
+ * materialized field, or `NULL`. The fields are serialized and duplicated as
+ * regular double vectors.
+ */
+
+static R_altrep_class_t duration_seq_class;
+
+// Below this, a regular vector is about as small as the ALTREP object itself
+static const r_ssize DURATION_SEQ_COMPACT_MIN = 64;
+
+struct duration_seq_info {
+  int64_t from;
+  int64_t by;
+  R_xlen_t size;
+  int field;
+};
+
+static
+inline
+duration_seq_info
+duration_seq_get_info(SEXP x) {
+  duration_seq_info out;
+  std::memcpy(&out, RAW(R_altrep_data1(x)), sizeof(out));
+  return out;
+}
+
+/*
+ * The order preserving `uint64_t` value of element `i`, before it is split
+ * into `lower` and `upper`, see `int64_unpack()`. The arithmetic is done on
+ * `uint64_t` so it wraps rather than overflows, the sequence itself is always
+ * in range.
+ */
+static
+inline
+uint64_t
+duration_seq_u64(const duration_seq_info& info, R_xlen_t i) {
+  const uint64_t elt =
+    static_cast<uint64_t>(info.from) +
+    static_cast<uint64_t>(info.by) * static_cast<uint64_t>(i);
+
+  return elt - static_cast<uint64_t>(std::numeric_limits<int64_t>::min());
+}
+
+static
+inline
+double
+duration_seq_lower(const duration_seq_info& info, R_xlen_t i) {
+  return static_cast<double>(duration_seq_u64(info, i) >> 32);
+}
+
+static
+inline
+double
+duration_seq_upper(const duration_seq_info& info, R_xlen_t i) {
+  return static_cast<double>(duration_seq_u64(info, i) & 0xFFFFFFFF);
+}
+
+static
+inline
+double
+duration_seq_elt_impl(const duration_seq_info& info, R_xlen_t i) {
+  return info.field == 0 ? duration_seq_lower(info, i) : duration_seq_upper(info, i);
+}
+
+static
+void
+duration_seq_compute(const duration_seq_info& info,
+                     R_xlen_t start,
+                     R_xlen_t size,
+                     double* p_out) {
+  if (info.field == 0) {
+    for (R_xlen_t i = 0; i < size; ++i) {
+      p_out[i] = duration_seq_lower(info, start + i);
+    }
+  } else {
+    for (R_xlen_t i = 0; i < size; ++i) {
+      p_out[i] = duration_seq_upper(info, start + i);
+    }
+  }
+}
+
+static
+SEXP
+duration_seq_materialize(SEXP x) {
+  SEXP out = R_altrep_data2(x);
+
+  if (out != R_NilValue) {
+    return out;
+  }
+
+  const duration_seq_info info = duration_seq_get_info(x);
+
+  out = PROTECT(Rf_allocVector(REALSXP, info.size));
+  duration_seq_compute(info, 0, info.size, REAL(out));
+
+  R_set_altrep_data2(x, out);
+
+  UNPROTECT(1);
+  return out;
+}
+
+static
+R_xlen_t
+duration_seq_length(SEXP x) {
+  return duration_seq_get_info(x).size;
+}
+
+static
+Rboolean
+duration_seq_inspect(SEXP x,
+                     int pre,
+                     int deep,
+                     int pvec,
+                     void (*inspect_subtree)(SEXP, int, int, int)) {
+  const duration_seq_info info = duration_seq_get_info(x);
+  const bool materialized = R_altrep_data2(x) != R_NilValue;
+
+  Rprintf(
+    "clock_duration_seq (from=%lld, by=%lld, field=%s, materialized=%s)\n",
+    static_cast<long long>(info.from),
+    static_cast<long long>(info.by),
+    info.field == 0 ? "lower" : "upper",
+    materialized ? "T" : "F"
+  );
+
+  return TRUE;
+}
+
+static
+void*
+duration_seq_dataptr(SEXP x, Rboolean writeable) {
+  return REAL(duration_seq_materialize(x));
+}
+
+static
+const void*
+duration_seq_dataptr_or_null(SEXP x) {
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 == R_NilValue) {
+    return NULL;
+  }
+
+  return REAL_RO(data2);
+}
+
+static
+double
+duration_seq_elt(SEXP x, R_xlen_t i) {
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 != R_NilValue) {
+    return REAL_RO(data2)[i];
+  }
+
+  return duration_seq_elt_impl(duration_seq_get_info(x), i);
+}
+
+static
+R_xlen_t
+duration_seq_get_region(SEXP x, R_xlen_t i, R_xlen_t n, double* buf) {
+  const duration_seq_info info = duration_seq_get_info(x);
+
+  // Only fill `buf` with elements that exist, like R's own `*_GET_REGION()`
+  if (i < 0 || i >= info.size || n <= 0) {
+    return 0;
+  }
+
+  n = std::min(n, info.size - i);
+
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 != R_NilValue) {
+    const double* p_data2 = REAL_RO(data2);
+    std::copy(p_data2 + i, p_data2 + i + n, buf);
+  } else {
+    duration_seq_compute(info, i, n, buf);
+  }
+
+  return n;
+}
+
+/*
+ * `indx` holds positive 1-based locations, possibly with missing values.
+ * Out of bounds locations result in missing values, like with `[`.
+ *
+ * This, `Is_sorted()`, and `Sum()` are computed from `from` and `by`, so they
+ * fall back to R's defaults once the sequence has been materialized, as
+ * `Dataptr()` may have handed out a writable pointer into `data2`. This
+ * follows R's own compact sequences.
+ */
+static
+SEXP
+duration_seq_extract_subset(SEXP x, SEXP indx, SEXP call) {
+  if (R_altrep_data2(x) != R_NilValue) {
+    return NULL;
+  }
+
+  const duration_seq_info info = duration_seq_get_info(x);
+
+  const R_xlen_t size = Rf_xlength(indx);
+  SEXP out = PROTECT(Rf_allocVector(REALSXP, size));
+  double* p_out = REAL(out);
+
+  switch (TYPEOF(indx)) {
+  case INTSXP: {
+    const int* p_indx = INTEGER_RO(indx);
+
+    for (R_xlen_t i = 0; i < size; ++i) {
+      const int loc = p_indx[i];
+
+      if (loc == NA_INTEGER || loc < 1 || loc > info.size) {
+        p_out[i] = NA_REAL;
+      } else {
+        p_out[i] = duration_seq_elt_impl(info, static_cast<R_xlen_t>(loc) - 1);
+      }
+    }
+
+    break;
+  }
+  case REALSXP: {
+    const double* p_indx = REAL_RO(indx);
+
+    for (R_xlen_t i = 0; i < size; ++i) {
+      const double loc = p_indx[i];
+
+      if (ISNAN(loc) || loc < 1 || loc >= static_cast<double>(info.size) + 1) {
+        p_out[i] = NA_REAL;
+      } else {
+        p_out[i] = duration_seq_elt_impl(info, static_cast<R_xlen_t>(loc) - 1);
+      }
+    }
+
+    break;
+  }
+  default: {
+    UNPROTECT(1);
+    return NULL;
+  }
+  }
+
+  UNPROTECT(1);
+  return out;
+}
+
+/*
+ * `lower` is always sorted in the direction of `by`, as it holds the high bits
+ * of an order preserving value. `upper` is too, but only while `lower` is
+ * constant, after which it wraps around.
+ */
+static
+int
+duration_seq_is_sorted(SEXP x) {
+  if (R_altrep_data2(x) != R_NilValue) {
+    return UNKNOWN_SORTEDNESS;
+  }
+
+  const duration_seq_info info = duration_seq_get_info(x);
+
+  if (info.field == 1) {
+    const double first = duration_seq_lower(info, 0);
+    const double last = duration_seq_lower(info, info.size - 1);
+
+    if (first != last) {
+      return UNKNOWN_SORTEDNESS;
+    }
+  }
+
+  return info.by < 0 ? SORTED_DECR : SORTED_INCR;
+}
+
+/*
+ * Only answered when `lower` is constant, in which case `lower` sums to a
+ * multiple of itself and `upper` is an arithmetic sequence. Returning `NULL`
+ * falls back to R's default.
+ */
+static
+SEXP
+duration_seq_sum(SEXP x, Rboolean narm) {
+  if (R_altrep_data2(x) != R_NilValue) {
+    return NULL;
+  }
+
+  const duration_seq_info info = duration_seq_get_info(x);
+
+  const double first = duration_seq_lower(info, 0);
+  const double last = duration_seq_lower(info, info.size - 1);
+
+  if (first != last) {
+    return NULL;
+  }
+
+  const double size = static_cast<double>(info.size);
+
+  if (info.field == 0) {
+    return Rf_ScalarReal(size * first);
+  }
+
+  const double start = duration_seq_upper(info, 0);
+  const double by = static_cast<double>(info.by);
+
+  return Rf_ScalarReal(size * start + by * (size * (size - 1) / 2));
+}
+
+static
+SEXP
+new_duration_seq_field(int64_t from, int64_t by, r_ssize size, int field) {
+  const duration_seq_info info{from, by, size, field};
+
+  SEXP data1 = PROTECT(Rf_allocVector(RAWSXP, sizeof(info)));
+  std::memcpy(RAW(data1), &info, sizeof(info));
+
+  SEXP out = R_new_altrep(duration_seq_class, data1, R_NilValue);
+
+  UNPROTECT(1);
+  return out;
+}
+
+/*
+ * `from + by * i` for `i` in `[0, size)` as the fields of a duration, compact
+ * if large enough
+ */
+template <class ClockDuration>
+static
+cpp11::writable::list
+duration_seq(const typename ClockDuration::chrono_duration& from,
+             const typename ClockDuration::chrono_duration& by,
+             const r_ssize& size) {
+  using Duration = typename ClockDuration::chrono_duration;
+
+  if (size < DURATION_SEQ_COMPACT_MIN) {
+    ClockDuration out(size);
+
+    for (r_ssize i = 0; i < size; ++i) {
+      const Duration elt = from + by * i;
+      out.assign(elt, i);
+    }
+
+    return out.to_list();
+  }
+
+  const int64_t from_i64 = static_cast<int64_t>(from.count());
+  const int64_t by_i64 = static_cast<int64_t>(by.count());
+
+  cpp11::sexp lower = new_duration_seq_field(from_i64, by_i64, size, 0);
+  cpp11::sexp upper = new_duration_seq_field(from_i64, by_i64, size, 1);
+
+  cpp11::writable::list out({lower, upper});
+  out.names() = {"lower", "upper"};
+
+  return out;
+}
+
+[[cpp11::init]]
+void
+clock_init_duration_seq(DllInfo* dll) {
+  duration_seq_class = R_make_altreal_class("clock_duration_seq", "clock", dll);
+
+  R_set_altrep_Length_method(duration_seq_class, duration_seq_length);
+  R_set_altrep_Inspect_method(duration_seq_class, duration_seq_inspect);
+
+  R_set_altvec_Dataptr_method(duration_seq_class, duration_seq_dataptr);
+  R_set_altvec_Dataptr_or_null_method(duration_seq_class, duration_seq_dataptr_or_null);
+  R_set_altvec_Extract_subset_method(duration_seq_class, duration_seq_extract_subset);
+
+  R_set_altreal_Elt_method(duration_seq_class, duration_seq_elt);
+  R_set_altreal_Get_region_method(duration_seq_class, duration_seq_get_region);
+  R_set_altreal_Is_sorted_method(duration_seq_class, duration_seq_is_sorted);
+  R_set_altreal_Sum_method(duration_seq_class, duration_seq_sum);
+}
+
+// -----------------------------------------------------------------------------
+
 template <class ClockDuration>
 static
 inline
@@ -1293,17 +1743,10 @@ duration_seq_by_lo_impl(cpp11::list_of<cpp11::doubles>& from_fields,
   const ClockDuration from{from_fields};
   const ClockDuration by{by_fields};
 
-  ClockDuration out(size);
-
   const Duration start = from[0];
   const Duration step = by[0];
 
-  for (r_ssize i = 0; i < size; ++i) {
-    const Duration elt = start + step * i;
-    out.assign(elt, i);
-  }
-
-  return out.to_list();
+  return duration_seq<ClockDuration>(start, step, size);
 }
 
 [[cpp11::register]]
@@ -1369,14 +1812,7 @@ duration_seq_to_by_impl(cpp11::list_of<cpp11::doubles>& from_fields,
     size = static_cast<r_ssize>(num / den + 1);
   }
 
-  ClockDuration out(size);
-
-  for (r_ssize i = 0; i < size; ++i) {
-    const Duration elt = start + step * i;
-    out.assign(elt, i);
-  }
-
-  return out.to_list();
+  return duration_seq<ClockDuration>(start, step, size);
 }
 
 [[cpp11::register]]
@@ -1416,13 +1852,12 @@ duration_seq_to_lo_impl(cpp11::list_of<cpp11::doubles>& from_fields,
   const ClockDuration from{from_fields};
   const ClockDuration to{to_fields};
 
-  ClockDuration out(size);
-
   const Duration start = from[0];
   const Duration end = to[0];
 
   if (size == 1) {
     // Avoid division by zero
+    ClockDuration out(size);
     out.assign(start, 0);
     return out.to_list();
   }
@@ -1442,12 +1877,7 @@ duration_seq_to_lo_impl(cpp11::list_of<cpp11::doubles>& from_fields,
 
   const Duration step{by};
 
-  for (r_ssize i = 0; i < size; ++i) {
-    const Duration elt = start + step * i;
-    out.assign(elt, i);
-  }
-
-  return out.to_list();
+  return duration_seq<ClockDuration>(start, step, size);
 }
 
 [[cpp11::register]]
@@ -1548,3 +1978,149 @@ duration_maximum_cpp(const cpp11::integers& precision_int) {
   default: never_reached("duration_maximum_cpp");
   }
 }
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Order proxy for durations, and the time points and zoned-times that share
+ * their layout
+ *
+ * Ordering within a single vector only needs the relative order of elements,
+ * so rather than the two column data frame proxy, this returns the dense rank
+ * of each element, with missing values kept as `NA`. vctrs and base R then
+ * order a single integer vector.
+ *
+ * The `lower` and `upper` fields already hold the two halves of an order
+ * preserving `uint64_t`, see `int64_pack()`, so the key is just the two
+ * halves put back together. Keys are sorted with a stable LSD radix sort on
+ * 16-bit digits, skipping any digit that is the same for every element, which
+ * is common for the high digits of time points in a limited range. Setting up
+ * the digit histograms costs about as much as a comparison sort of a few
+ * thousand elements, so smaller inputs are sorted with `std::sort()` instead.
+ */
+
+static const int DURATION_RADIX_BITS = 16;
+static const int DURATION_RADIX_SIZE = 1 << DURATION_RADIX_BITS;
+static const int DURATION_RADIX_PASSES = 64 / DURATION_RADIX_BITS;
+static const r_ssize DURATION_RADIX_MIN_SIZE = 8192;
+
+static
+inline
+uint64_t
+duration_radix_digit(uint64_t key, int pass) {
+  return (key >> (pass * DURATION_RADIX_BITS)) & (DURATION_RADIX_SIZE - 1);
+}
+
+[[cpp11::register]]
+cpp11::writable::integers
+duration_proxy_order_cpp(cpp11::list_of<cpp11::doubles> fields) {
+  const cpp11::doubles lower = fields[0];
+  const cpp11::doubles upper = fields[1];
+
+  const r_ssize size = lower.size();
+
+  const double* p_lower = REAL_RO(lower);
+  const double* p_upper = REAL_RO(upper);
+
+  cpp11::writable::integers out(size);
+  int* p_out = INTEGER(out);
+
+  // Keys and locations of non-missing elements, and their sorted copies
+  std::vector<uint64_t> keys;
+  std::vector<int> locs;
+  keys.reserve(size);
+  locs.reserve(size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (r_dbl_is_missing(p_lower[i])) {
+      p_out[i] = r_int_na;
+      continue;
+    }
+
+    const uint64_t key =
+      (static_cast<uint64_t>(p_lower[i]) << 32) |
+      static_cast<uint64_t>(p_upper[i]);
+
+    keys.push_back(key);
+    locs.push_back(static_cast<int>(i));
+  }
+
+  const r_ssize n = static_cast<r_ssize>(keys.size());
+
+  if (n == 0) {
+    return out;
+  }
+
+  if (n < DURATION_RADIX_MIN_SIZE) {
+    std::vector<r_ssize> order(n);
+
+    for (r_ssize i = 0; i < n; ++i) {
+      order[i] = i;
+    }
+
+    std::sort(order.begin(), order.end(), [&](r_ssize x, r_ssize y) {
+      return keys[x] < keys[y];
+    });
+
+    int rank = 1;
+    p_out[locs[order[0]]] = rank;
+
+    for (r_ssize i = 1; i < n; ++i) {
+      rank += keys[order[i]] != keys[order[i - 1]];
+      p_out[locs[order[i]]] = rank;
+    }
+
+    return out;
+  }
+
+  // Histograms of every digit in a single pass
+  std::vector<r_ssize> counts(DURATION_RADIX_PASSES * DURATION_RADIX_SIZE, 0);
+
+  for (r_ssize i = 0; i < n; ++i) {
+    const uint64_t key = keys[i];
+
+    for (int pass = 0; pass < DURATION_RADIX_PASSES; ++pass) {
+      ++counts[pass * DURATION_RADIX_SIZE + duration_radix_digit(key, pass)];
+    }
+  }
+
+  std::vector<uint64_t> keys_tmp(n);
+  std::vector<int> locs_tmp(n);
+
+  for (int pass = 0; pass < DURATION_RADIX_PASSES; ++pass) {
+    r_ssize* p_counts = counts.data() + pass * DURATION_RADIX_SIZE;
+
+    // Every element shares this digit, so the pass is a no-op
+    if (p_counts[duration_radix_digit(keys[0], pass)] == n) {
+      continue;
+    }
+
+    // Counts to starting offsets
+    r_ssize offset = 0;
+    for (int digit = 0; digit < DURATION_RADIX_SIZE; ++digit) {
+      const r_ssize count = p_counts[digit];
+      p_counts[digit] = offset;
+      offset += count;
+    }
+
+    for (r_ssize i = 0; i < n; ++i) {
+      const uint64_t key = keys[i];
+      const r_ssize loc = p_counts[duration_radix_digit(key, pass)]++;
+      keys_tmp[loc] = key;
+      locs_tmp[loc] = locs[i];
+    }
+
+    keys.swap(keys_tmp);
+    locs.swap(locs_tmp);
+  }
+
+  int rank = 1;
+  p_out[locs[0]] = rank;
+
+  for (r_ssize i = 1; i < n; ++i) {
+    rank += keys[i] != keys[i - 1];
+    p_out[locs[i]] = rank;
+  }
+
+  return out;
+}
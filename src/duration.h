@@ -7,6 +7,7 @@
 #include "utils.h"
 
 #include <limits>
+#include <cstring>
 
 namespace rclock {
 
@@ -27,6 +28,9 @@ public:
 
   CONSTCD14 Duration operator[](r_ssize i) const NOEXCEPT;
 
+  bool get_block(int64_t* p_out, r_ssize start, r_ssize size) const;
+  void assign_block(const int64_t* p_x, r_ssize start, r_ssize size);
+
   cpp11::writable::list to_list() const;
 
   // Only used by `zoned-time.cpp`
@@ -52,6 +56,19 @@ protected:
   rclock::doubles upper_;
 };
 
+/*
+ * Kernels that work on blocks of packed `int64_t` values, see `get_block()`,
+ * process `block_size` elements at a time using stack buffers. Missing values
+ * are represented by `block_na` in those buffers.
+ *
+ * `block_na` is also the smallest value of the 64-bit durations, i.e. their
+ * `clock_minimum()`, so it can't be relied on alone. `get_block()` reports
+ * when a block holds it as a non-missing value, and kernels that produce it as
+ * a result have to `assign()` it after `assign_block()`.
+ */
+static const r_ssize block_size = 1024;
+static const int64_t block_na = std::numeric_limits<int64_t>::min();
+
 using years = duration<date::years>;
 using quarters = duration<quarterly::quarters>;
 using months = duration<date::months>;
@@ -147,6 +164,17 @@ namespace detail {
  * remap the `int64_t` value into `uint64_t` space, while maintaining order.
  * This relies on unsigned arithmetic overflow behavior, which is well-defined.
  *
+ * This layout is deliberately not a single column holding the `int64_t` bit
+ * pattern (like bit64's `integer64`). vctrs compares, orders, and detects
+ * missing values in each field as a plain double, so the bit pattern of a
+ * negative value would sort incorrectly and some patterns would be
+ * indistinguishable from `NaN`.
+ *
+ * Besides this class and the block API below, this layout is relied on by
+ * `duration_seq_u64()` and the compact sequence fields, which build the two
+ * halves themselves, and by `duration_proxy_order_cpp()` and the lazy
+ * year-month-day fields, which read `lower` and `upper` directly.
+ *
  * Taken from vctrs:
  * https://github.com/r-lib/vctrs/blob/c27b6988bd2f02aa970b6d14a640eccb299e03bb/src/type-integer64.c#L117-L156
  */
@@ -183,6 +211,100 @@ int64_t int64_pack(double left, double right)
   return out;
 }
 
+/*
+ * Block versions of `int64_pack()` and `int64_unpack()`.
+ *
+ * Rather than casting, the `uint32_t` halves are converted to and from their
+ * doubles with the "magic number" trick. Adding 2^52 to a double holding an
+ * integer in `[0, 2^32)` leaves that integer in the low bits of the mantissa,
+ * and the reverse recovers the double. Along with selecting missing values
+ * rather than branching on them, this keeps the loops free of calls and
+ * branches, so the compiler can vectorize them with whatever SIMD instructions
+ * the target has (at least SSE2 on x86-64) without intrinsics.
+ *
+ * Missing values are packed as `block_na`. Returns whether any non-missing
+ * value was packed as `block_na` too, see `block_na`.
+ */
+
+static const double two_pow_52 = 4503599627370496.0;
+static const uint64_t two_pow_52_bits = 0x4330000000000000;
+static const uint64_t low_32_bits = 0xFFFFFFFF;
+
+static
+inline
+uint64_t
+dbl_to_bits(double x)
+{
+  uint64_t out;
+  std::memcpy(&out, &x, sizeof(out));
+  return out;
+}
+
+static
+inline
+double
+bits_to_dbl(uint64_t x)
+{
+  double out;
+  std::memcpy(&out, &x, sizeof(out));
+  return out;
+}
+
+static
+inline
+bool
+int64_pack_block(const double* p_lower,
+                 const double* p_upper,
+                 r_ssize size,
+                 int64_t* p_out)
+{
+  bool has_min = false;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const double lower = p_lower[i];
+    const double upper = p_upper[i];
+
+    const uint64_t left_u64 = dbl_to_bits(lower + two_pow_52) & low_32_bits;
+    const uint64_t right_u64 = dbl_to_bits(upper + two_pow_52) & low_32_bits;
+
+    const uint64_t out_u64 = left_u64 << 32 | right_u64;
+    const int64_t out = static_cast<int64_t>(out_u64 + std::numeric_limits<int64_t>::min());
+
+    const bool na = std::isnan(lower);
+
+    p_out[i] = na ? block_na : out;
+    has_min |= !na & (out == block_na);
+  }
+
+  return has_min;
+}
+
+static
+inline
+void
+int64_unpack_block(const int64_t* p_x,
+                   r_ssize size,
+                   double* p_lower,
+                   double* p_upper)
+{
+  const uint64_t na_bits = dbl_to_bits(r_dbl_na);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const int64_t x = p_x[i];
+    const uint64_t x_u64 = static_cast<uint64_t>(x) - std::numeric_limits<int64_t>::min();
+
+    const double lower = bits_to_dbl(two_pow_52_bits | (x_u64 >> 32)) - two_pow_52;
+    const double upper = bits_to_dbl(two_pow_52_bits | (x_u64 & low_32_bits)) - two_pow_52;
+
+    // Selecting between doubles isn't reliably if-converted, but masking
+    // their bits is
+    const uint64_t na_mask = -static_cast<uint64_t>(x == block_na);
+
+    p_lower[i] = bits_to_dbl((dbl_to_bits(lower) & ~na_mask) | (na_bits & na_mask));
+    p_upper[i] = bits_to_dbl((dbl_to_bits(upper) & ~na_mask) | (na_bits & na_mask));
+  }
+}
+
 } // namespace details
 
 template <typename Duration>
@@ -208,6 +330,30 @@ duration<Duration>::operator[](r_ssize i) const NOEXCEPT
   return Duration{elt};
 }
 
+/*
+ * Read elements `[start, start + size)` into `p_out` as packed `int64_t`
+ * values, with missing values as `block_na`. Returns `true` if a non-missing
+ * value is also `block_na`, in which case `is_na()` has to be used to tell
+ * them apart.
+ */
+template <typename Duration>
+inline
+bool
+duration<Duration>::get_block(int64_t* p_out, r_ssize start, r_ssize size) const
+{
+  return detail::int64_pack_block(lower_.data() + start, upper_.data() + start, size, p_out);
+}
+
+template <typename Duration>
+inline
+void
+duration<Duration>::assign_block(const int64_t* p_x, r_ssize start, r_ssize size)
+{
+  double* p_lower = lower_.data_writable() + start;
+  double* p_upper = upper_.data_writable() + start;
+  detail::int64_unpack_block(p_x, size, p_lower, p_upper);
+}
+
 template <typename Duration>
 inline
 cpp11::writable::list
@@ -4,6 +4,7 @@
 #include "enums.h"
 #include "resolve.h"
 #include "zone.h"
+#include "zone-cursor.h"
 #include "fill.h"
 #include "failure.h"
 #include <sstream>
@@ -1217,6 +1218,12 @@ cpp11::writable::strings format_zoned_time_impl(cpp11::list_of<cpp11::doubles>&
   const char* decimal_mark_char = decimal_mark_string.c_str();
 
   rclock::failures fail{};
+  rclock::zone_cursor cursor{p_time_zone};
+
+  // Fixed offset zones, like UTC, only need to be looked up once
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+  const bool fixed = table.is_fixed();
+  const date::sys_info fixed_info = fixed ? table.fixed_info() : date::sys_info{};
 
   for (r_ssize i = 0; i < size; ++i) {
     if (x.is_na(i)) {
@@ -1227,7 +1234,7 @@ cpp11::writable::strings format_zoned_time_impl(cpp11::list_of<cpp11::doubles>&
     const Duration duration = x[i];
     const date::sys_time<Duration> stp{duration};
 
-    const date::sys_info info = rclock::get_info(stp, p_time_zone);
+    const date::sys_info& info = fixed ? fixed_info : cursor.get_info(stp);
 
     const std::chrono::seconds offset = info.offset;
 
@@ -0,0 +1,334 @@
+#include "clock.h"
+#include "altrep.h"
+#include "calendar.h"
+#include "duration.h"
+#include "enums.h"
+#include <algorithm>
+#include <vector>
+
+/*
+ * Lazy year-month-day fields of a sys-time
+ *
+ * `as_year_month_day()` on a time point returns fields backed by this ALTREP
+ * class rather than computing all of them up front. Each field remembers the
+ * `lower` and `upper` fields of the time point it came from, and computes
+ * itself from them on access:
+ *
+ * - `Elt()` and `Get_region()` compute only the requested elements, so code
+ *   that iterates over a field never materializes it.
+ * - Anything that needs a data pointer materializes the whole field in one
+ *   pass. The time point's fields are released at that point.
+ *
+ * This makes extracting a single component, like `get_year()` on a large
+ * date-time, cost one pass and one integer vector rather than one of each per
+ * field. Fields are serialized and duplicated as regular integer vectors.
+ *
+ * `data1` is a list of `lower`, `upper`, and an integer vector holding the
+ * precision and `component`, and is `NULL` once materialized. `data2` is the
+ * materialized field, or `NULL`.
+ */
+
+static R_altrep_class_t ymd_field_class;
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Component of the smallest value of a `Duration`, which is packed the same
+ * way as a missing value, see `block_na`
+ */
+template <class Duration>
+static
+inline
+void
+ymd_field_compute_min(const int64_t* p_x,
+                      const double* p_lower,
+                      const R_xlen_t& size,
+                      const enum component& component_val,
+                      int* p_out) {
+  using Rep = typename Duration::rep;
+
+  for (R_xlen_t i = 0; i < size; ++i) {
+    if (p_x[i] == rclock::duration::block_na && !std::isnan(p_lower[i])) {
+      const Duration elt{static_cast<Rep>(p_x[i])};
+      p_out[i] = get_ymd_component_one(elt, component_val);
+    }
+  }
+}
+
+/*
+ * Compute elements `[start, start + size)` of the field `x` into `p_out`,
+ * a block at a time
+ */
+static
+void
+ymd_field_compute(SEXP x, R_xlen_t start, R_xlen_t size, int* p_out) {
+  using rclock::duration::block_size;
+
+  const SEXP data1 = R_altrep_data1(x);
+  const SEXP lower = VECTOR_ELT(data1, 0);
+  const SEXP upper = VECTOR_ELT(data1, 1);
+  const int* p_info = INTEGER_RO(VECTOR_ELT(data1, 2));
+
+  const enum precision precision_val = static_cast<enum precision>(p_info[0]);
+  const enum component component_val = static_cast<enum component>(p_info[1]);
+
+  // `*_GET_REGION()` rather than `REAL_RO()`, as the time point's fields may
+  // themselves be ALTREP vectors
+  double lower_block[block_size];
+  double upper_block[block_size];
+  int64_t block[block_size];
+
+  for (R_xlen_t offset = 0; offset < size; offset += block_size) {
+    const R_xlen_t n = std::min(static_cast<R_xlen_t>(block_size), size - offset);
+
+    REAL_GET_REGION(lower, start + offset, n, lower_block);
+    REAL_GET_REGION(upper, start + offset, n, upper_block);
+    const bool has_min = rclock::duration::detail::int64_pack_block(lower_block, upper_block, n, block);
+
+    int* p_out_block = p_out + offset;
+
+    switch (precision_val) {
+    case precision::day: get_ymd_component_block<date::days>(block, n, component_val, p_out_block); break;
+    case precision::hour: get_ymd_component_block<std::chrono::hours>(block, n, component_val, p_out_block); break;
+    case precision::minute: get_ymd_component_block<std::chrono::minutes>(block, n, component_val, p_out_block); break;
+    case precision::second: get_ymd_component_block<std::chrono::seconds>(block, n, component_val, p_out_block); break;
+    case precision::millisecond: get_ymd_component_block<std::chrono::milliseconds>(block, n, component_val, p_out_block); break;
+    case precision::microsecond: get_ymd_component_block<std::chrono::microseconds>(block, n, component_val, p_out_block); break;
+    case precision::nanosecond: get_ymd_component_block<std::chrono::nanoseconds>(block, n, component_val, p_out_block); break;
+    default: Rf_error("Internal error: Reached the unreachable in `ymd_field_compute()`.");
+    }
+
+    if (!has_min) {
+      continue;
+    }
+
+    // Only the 64-bit durations can hold the smallest `int64_t`
+    switch (precision_val) {
+    case precision::hour: ymd_field_compute_min<std::chrono::hours>(block, lower_block, n, component_val, p_out_block); break;
+    case precision::minute: ymd_field_compute_min<std::chrono::minutes>(block, lower_block, n, component_val, p_out_block); break;
+    case precision::second: ymd_field_compute_min<std::chrono::seconds>(block, lower_block, n, component_val, p_out_block); break;
+    case precision::millisecond: ymd_field_compute_min<std::chrono::milliseconds>(block, lower_block, n, component_val, p_out_block); break;
+    case precision::microsecond: ymd_field_compute_min<std::chrono::microseconds>(block, lower_block, n, component_val, p_out_block); break;
+    case precision::nanosecond: ymd_field_compute_min<std::chrono::nanoseconds>(block, lower_block, n, component_val, p_out_block); break;
+    default: break;
+    }
+  }
+}
+
+static
+SEXP
+ymd_field_materialize(SEXP x) {
+  SEXP out = R_altrep_data2(x);
+
+  if (out != R_NilValue) {
+    return out;
+  }
+
+  const R_xlen_t size = Rf_xlength(VECTOR_ELT(R_altrep_data1(x), 0));
+
+  out = PROTECT(Rf_allocVector(INTSXP, size));
+  ymd_field_compute(x, 0, size, INTEGER(out));
+
+  R_set_altrep_data2(x, out);
+  R_set_altrep_data1(x, R_NilValue);
+
+  UNPROTECT(1);
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
+static
+R_xlen_t
+ymd_field_length(SEXP x) {
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 != R_NilValue) {
+    return Rf_xlength(data2);
+  }
+
+  return Rf_xlength(VECTOR_ELT(R_altrep_data1(x), 0));
+}
+
+static
+Rboolean
+ymd_field_inspect(SEXP x,
+                  int pre,
+                  int deep,
+                  int pvec,
+                  void (*inspect_subtree)(SEXP, int, int, int)) {
+  const bool materialized = R_altrep_data2(x) != R_NilValue;
+  Rprintf("clock_ymd_field (materialized=%s)\n", materialized ? "T" : "F");
+  return TRUE;
+}
+
+static
+void*
+ymd_field_dataptr(SEXP x, Rboolean writeable) {
+  return INTEGER(ymd_field_materialize(x));
+}
+
+static
+const void*
+ymd_field_dataptr_or_null(SEXP x) {
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 == R_NilValue) {
+    return NULL;
+  }
+
+  return INTEGER_RO(data2);
+}
+
+static
+int
+ymd_field_elt(SEXP x, R_xlen_t i) {
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 != R_NilValue) {
+    return INTEGER_RO(data2)[i];
+  }
+
+  int out;
+  ymd_field_compute(x, i, 1, &out);
+  return out;
+}
+
+static
+R_xlen_t
+ymd_field_get_region(SEXP x, R_xlen_t i, R_xlen_t n, int* buf) {
+  const R_xlen_t size = ymd_field_length(x);
+
+  // Only fill `buf` with elements that exist, like R's own `*_GET_REGION()`
+  if (i < 0 || i >= size || n <= 0) {
+    return 0;
+  }
+
+  n = std::min(n, size - i);
+
+  const SEXP data2 = R_altrep_data2(x);
+
+  if (data2 != R_NilValue) {
+    const int* p_data2 = INTEGER_RO(data2);
+    std::copy(p_data2 + i, p_data2 + i + n, buf);
+  } else {
+    ymd_field_compute(x, i, n, buf);
+  }
+
+  return n;
+}
+
+// -----------------------------------------------------------------------------
+
+static
+SEXP
+new_ymd_field(SEXP lower,
+              SEXP upper,
+              const enum precision& precision_val,
+              const enum component& component_val) {
+  SEXP info = PROTECT(Rf_allocVector(INTSXP, 2));
+  int* p_info = INTEGER(info);
+  p_info[0] = static_cast<int>(precision_val);
+  p_info[1] = static_cast<int>(component_val);
+
+  SEXP data1 = PROTECT(Rf_allocVector(VECSXP, 3));
+  SET_VECTOR_ELT(data1, 0, lower);
+  SET_VECTOR_ELT(data1, 1, upper);
+  SET_VECTOR_ELT(data1, 2, info);
+
+  SEXP out = R_new_altrep(ymd_field_class, data1, R_NilValue);
+
+  UNPROTECT(2);
+  return out;
+}
+
+[[cpp11::register]]
+cpp11::writable::list
+as_year_month_day_from_sys_time_cpp(cpp11::list_of<cpp11::doubles> fields,
+                                    const cpp11::integers& precision_int) {
+  const enum precision precision_val = parse_precision(precision_int);
+
+  r_ssize n_fields;
+  enum component subsecond = component::nanosecond;
+
+  switch (precision_val) {
+  case precision::day: n_fields = 3; break;
+  case precision::hour: n_fields = 4; break;
+  case precision::minute: n_fields = 5; break;
+  case precision::second: n_fields = 6; break;
+  case precision::millisecond: n_fields = 7; subsecond = component::millisecond; break;
+  case precision::microsecond: n_fields = 7; subsecond = component::microsecond; break;
+  case precision::nanosecond: n_fields = 7; subsecond = component::nanosecond; break;
+  default: clock_abort("Internal error: Invalid precision.");
+  }
+
+  static const char* names_all[] = {
+    "year", "month", "day", "hour", "minute", "second", "subsecond"
+  };
+  const enum component components_all[] = {
+    component::year,
+    component::month,
+    component::day,
+    component::hour,
+    component::minute,
+    component::second,
+    subsecond
+  };
+
+  const SEXP lower = fields[0];
+  const SEXP upper = fields[1];
+
+  cpp11::writable::list out(n_fields);
+  cpp11::writable::strings names(n_fields);
+
+  for (r_ssize i = 0; i < n_fields; ++i) {
+    out[i] = new_ymd_field(lower, upper, precision_val, components_all[i]);
+    names[i] = names_all[i];
+  }
+
+  out.names() = names;
+
+  return out;
+}
+
+/*
+ * For testing `Get_region()` outside of the range R itself asks for.
+ * `materialize` materializes the field first.
+ */
+[[cpp11::register]]
+cpp11::writable::integers
+ymd_field_get_region_cpp(SEXP x, double start, double size, bool materialize) {
+  if (materialize) {
+    ymd_field_materialize(x);
+  }
+
+  const R_xlen_t n = static_cast<R_xlen_t>(size);
+  std::vector<int> buf(n);
+
+  const R_xlen_t n_filled = INTEGER_GET_REGION(x, static_cast<R_xlen_t>(start), n, buf.data());
+
+  cpp11::writable::integers out(n_filled);
+
+  for (R_xlen_t i = 0; i < n_filled; ++i) {
+    out[i] = buf[i];
+  }
+
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
+[[cpp11::init]]
+void
+clock_init_year_month_day_lazy(DllInfo* dll) {
+  ymd_field_class = R_make_altinteger_class("clock_ymd_field", "clock", dll);
+
+  R_set_altrep_Length_method(ymd_field_class, ymd_field_length);
+  R_set_altrep_Inspect_method(ymd_field_class, ymd_field_inspect);
+
+  R_set_altvec_Dataptr_method(ymd_field_class, ymd_field_dataptr);
+  R_set_altvec_Dataptr_or_null_method(ymd_field_class, ymd_field_dataptr_or_null);
+
+  R_set_altinteger_Elt_method(ymd_field_class, ymd_field_elt);
+  R_set_altinteger_Get_region_method(ymd_field_class, ymd_field_get_region);
+}
@@ -4,6 +4,8 @@
 #include "enums.h"
 #include "get.h"
 #include "parse.h"
+#include "parse-program.h"
+#include "parse-memo.h"
 #include "failure.h"
 #include "fill.h"
 #include "rcrd.h"
@@ -297,25 +299,6 @@ as_sys_time_year_month_day_cpp(cpp11::list_of<cpp11::integers> fields,
 
 // -----------------------------------------------------------------------------
 
-[[cpp11::register]]
-cpp11::writable::list
-as_year_month_day_from_sys_time_cpp(cpp11::list_of<cpp11::doubles> fields,
-                                    const cpp11::integers& precision_int) {
-  using namespace rclock;
-
-  switch (parse_precision(precision_int)) {
-  case precision::day: return as_calendar_from_sys_time_impl<duration::days, gregorian::ymd>(fields);
-  case precision::hour: return as_calendar_from_sys_time_impl<duration::hours, gregorian::ymdh>(fields);
-  case precision::minute: return as_calendar_from_sys_time_impl<duration::minutes, gregorian::ymdhm>(fields);
-  case precision::second: return as_calendar_from_sys_time_impl<duration::seconds, gregorian::ymdhms>(fields);
-  case precision::millisecond: return as_calendar_from_sys_time_impl<duration::milliseconds, gregorian::ymdhmss<std::chrono::milliseconds>>(fields);
-  case precision::microsecond: return as_calendar_from_sys_time_impl<duration::microseconds, gregorian::ymdhmss<std::chrono::microseconds>>(fields);
-  case precision::nanosecond: return as_calendar_from_sys_time_impl<duration::nanoseconds, gregorian::ymdhmss<std::chrono::nanoseconds>>(fields);
-  default: clock_abort("Internal error: Invalid precision.");
-  }
-
-  never_reached("as_year_month_day_from_sys_time_cpp");
-}
 
 // -----------------------------------------------------------------------------
 
@@ -385,311 +368,201 @@ year_month_day_minus_year_month_day_cpp(cpp11::list_of<cpp11::integers> x,
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Each `year_month_day_from_stream()` returns the index of the format that
+ * parsed `p_elt`, or `-1` on failure
+ */
+
 // Default impl applies to millisecond/microsecond/nanosecond parsers
 template <class Calendar>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            Calendar& out) {
   using Duration = typename Calendar::duration;
-  const r_ssize size = fmts.size();
 
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
+  const r_ssize n_programs = programs.size();
 
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year_month_day ymd{};
     date::hh_mm_ss<Duration> hms{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      ymd,
-      hms
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, ymd, hms)) {
       out.assign_year_month_day(ymd, i);
       out.assign_hour(hms.hours(), i);
       out.assign_minute(hms.minutes(), i);
       out.assign_second(hms.seconds(), i);
       out.assign_subsecond(hms.subseconds(), i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            rclock::gregorian::y& out) {
-  const r_ssize size = fmts.size();
+  const r_ssize n_programs = programs.size();
 
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
-
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year x{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      x
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, x)) {
       out.assign_year(x, i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            rclock::gregorian::ym& out) {
-  const r_ssize size = fmts.size();
-
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
+  const r_ssize n_programs = programs.size();
 
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year_month x{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      x
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, x)) {
       out.assign_year_month(x, i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            rclock::gregorian::ymd& out) {
-  const r_ssize size = fmts.size();
-
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
+  const r_ssize n_programs = programs.size();
 
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year_month_day x{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      x
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, x)) {
       out.assign_year_month_day(x, i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            rclock::gregorian::ymdh& out) {
-  const r_ssize size = fmts.size();
+  const r_ssize n_programs = programs.size();
 
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
-
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year_month_day ymd{};
     date::hh_mm_ss<std::chrono::seconds> hms{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      ymd,
-      hms
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, ymd, hms)) {
       out.assign_year_month_day(ymd, i);
       out.assign_hour(hms.hours(), i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            rclock::gregorian::ymdhm& out) {
-  const r_ssize size = fmts.size();
-
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
+  const r_ssize n_programs = programs.size();
 
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year_month_day ymd{};
     date::hh_mm_ss<std::chrono::seconds> hms{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      ymd,
-      hms
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, ymd, hms)) {
       out.assign_year_month_day(ymd, i);
       out.assign_hour(hms.hours(), i);
       out.assign_minute(hms.minutes(), i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <>
 inline
-void
-year_month_day_from_stream(std::istringstream& stream,
-                           const std::vector<std::string>& fmts,
-                           const std::pair<const std::string*, const std::string*>& month_names_pair,
-                           const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                           const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                           const char& decimal_mark,
+r_ssize
+year_month_day_from_stream(rclock::parse_stream& stream,
+                           const char* p_elt,
+                           rclock::parse_programs& programs,
                            const r_ssize& i,
                            rclock::failures& fail,
                            rclock::gregorian::ymdhms& out) {
-  const r_ssize size = fmts.size();
-
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
+  const r_ssize n_programs = programs.size();
 
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::year_month_day ymd{};
     date::hh_mm_ss<std::chrono::seconds> hms{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      decimal_mark,
-      ymd,
-      hms
-    );
-
-    if (!stream.fail()) {
+    if (programs[k].parse(stream, p_elt, ymd, hms)) {
       out.assign_year_month_day(ymd, i);
       out.assign_hour(hms.hours(), i);
       out.assign_minute(hms.minutes(), i);
       out.assign_second(hms.seconds(), i);
-      return;
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
   out.assign_na(i);
+  return -1;
 }
 
 template <class Calendar>
@@ -736,9 +609,20 @@ year_month_day_parse_impl(const cpp11::strings& x,
     ampm_names
   );
 
+  rclock::parse_programs programs(
+    fmts,
+    month_names_pair,
+    weekday_names_pair,
+    ampm_names_pair,
+    dmark
+  );
+
   rclock::failures fail{};
 
-  std::istringstream stream;
+  rclock::parse_stream stream;
+
+  // Repeated strings copy the element where they were first parsed
+  rclock::parse_memo<r_ssize> memo;
 
   void* vmax = vmaxget();
 
@@ -750,29 +634,42 @@ year_month_day_parse_impl(const cpp11::strings& x,
       continue;
     }
 
-    const char* p_elt = Rf_translateCharUTF8(elt);
+    const rclock::parse_memo<r_ssize>::entry* p_memo = memo.find(elt);
+
+    if (p_memo != NULL) {
+      if (p_memo->format == -1) {
+        fail.write(i);
+        out.assign_na(i);
+      } else {
+        out.copy(p_memo->value, i);
+        programs.repeat(p_memo->format);
+      }
+      continue;
+    }
 
-    stream.str(p_elt);
+    const char* p_elt = Rf_translateCharUTF8(elt);
 
-    year_month_day_from_stream(
+    const r_ssize format = year_month_day_from_stream(
       stream,
-      fmts,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
+      p_elt,
+      programs,
       i,
       fail,
       out
     );
-  }
 
-  vmaxset(vmax);
+    memo.insert(elt, i, format);
+
+    // Release the translation of `elt`, if it needed one
+    vmaxset(vmax);
+  }
 
   if (fail.any_failures()) {
     fail.warn_parse();
   }
 
+  programs.signal_hits();
+
   return out.to_list();
 }
 
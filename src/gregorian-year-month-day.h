@@ -45,6 +45,7 @@ public:
 
   void assign_year(const date::year& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   date::year to_year(r_ssize i) const NOEXCEPT;
   cpp11::writable::list to_list() const;
@@ -67,6 +68,7 @@ public:
   void assign_month(const date::month& x, r_ssize i) NOEXCEPT;
   void assign_year_month(const date::year_month& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   date::year_month to_year_month(r_ssize i) const NOEXCEPT;
   cpp11::writable::list to_list() const;
@@ -89,6 +91,7 @@ public:
   void assign_year_month_day(const date::year_month_day& x, r_ssize i) NOEXCEPT;
   void assign_sys_time(const date::sys_time<date::days>& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   void resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call);
 
@@ -114,6 +117,7 @@ public:
   void assign_hour(const std::chrono::hours& x, r_ssize i) NOEXCEPT;
   void assign_sys_time(const date::sys_time<std::chrono::hours>& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   void resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call);
 
@@ -139,6 +143,7 @@ public:
   void assign_minute(const std::chrono::minutes& x, r_ssize i) NOEXCEPT;
   void assign_sys_time(const date::sys_time<std::chrono::minutes>& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   void resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call);
 
@@ -165,6 +170,7 @@ public:
   void assign_second(const std::chrono::seconds& x, r_ssize i) NOEXCEPT;
   void assign_sys_time(const date::sys_time<std::chrono::seconds>& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   void resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call);
 
@@ -193,6 +199,7 @@ public:
   void assign_subsecond(const Duration& x, r_ssize i) NOEXCEPT;
   void assign_sys_time(const date::sys_time<Duration>& x, r_ssize i) NOEXCEPT;
   void assign_na(r_ssize i) NOEXCEPT;
+  void copy(r_ssize from, r_ssize to) NOEXCEPT;
 
   void resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call);
 
@@ -259,6 +266,13 @@ y::assign_na(r_ssize i) NOEXCEPT
   year_.assign_na(i);
 }
 
+inline
+void
+y::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  year_.assign(year_[from], to);
+}
+
 inline
 date::year
 y::to_year(r_ssize i) const NOEXCEPT
@@ -331,6 +345,14 @@ ym::assign_na(r_ssize i) NOEXCEPT
   month_.assign_na(i);
 }
 
+inline
+void
+ym::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  y::copy(from, to);
+  month_.assign(month_[from], to);
+}
+
 inline
 date::year_month
 ym::to_year_month(r_ssize i) const NOEXCEPT
@@ -405,6 +427,14 @@ ymd::assign_na(r_ssize i) NOEXCEPT
   day_.assign_na(i);
 }
 
+inline
+void
+ymd::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  ym::copy(from, to);
+  day_.assign(day_[from], to);
+}
+
 inline
 void
 ymd::resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call)
@@ -516,6 +546,14 @@ ymdh::assign_na(r_ssize i) NOEXCEPT
   hour_.assign_na(i);
 }
 
+inline
+void
+ymdh::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  ymd::copy(from, to);
+  hour_.assign(hour_[from], to);
+}
+
 inline
 void
 ymdh::resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call)
@@ -630,6 +668,14 @@ ymdhm::assign_na(r_ssize i) NOEXCEPT
   minute_.assign_na(i);
 }
 
+inline
+void
+ymdhm::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  ymdh::copy(from, to);
+  minute_.assign(minute_[from], to);
+}
+
 inline
 void
 ymdhm::resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call)
@@ -748,6 +794,14 @@ ymdhms::assign_na(r_ssize i) NOEXCEPT
   second_.assign_na(i);
 }
 
+inline
+void
+ymdhms::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  ymdhm::copy(from, to);
+  second_.assign(second_[from], to);
+}
+
 inline
 void
 ymdhms::resolve(r_ssize i, const enum invalid type, const cpp11::sexp& call)
@@ -876,6 +930,15 @@ ymdhmss<Duration>::assign_na(r_ssize i) NOEXCEPT
   subsecond_.assign_na(i);
 }
 
+template <typename Duration>
+inline
+void
+ymdhmss<Duration>::copy(r_ssize from, r_ssize to) NOEXCEPT
+{
+  ymdhms::copy(from, to);
+  subsecond_.assign(subsecond_[from], to);
+}
+
 template <typename Duration>
 inline
 void
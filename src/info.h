@@ -0,0 +1,216 @@
+#ifndef CLOCK_INFO_H
+#define CLOCK_INFO_H
+
+#include "clock.h"
+#include "duration.h"
+#include "utils.h"
+#include <string>
+#include <unordered_map>
+
+// -----------------------------------------------------------------------------
+
+namespace rclock {
+
+/*
+ * The columns of a `sys_time_info()` data frame. This is also used for the
+ * `first` and `second` df-cols of `naive_time_info()`.
+ *
+ * `columns` is a logical vector flagging which of `begin`, `end`, `offset`,
+ * `dst`, and `abbreviation` were requested, in that order. Only the requested
+ * columns are allocated and filled.
+ *
+ * Abbreviations are interned once per distinct abbreviation rather than once
+ * per element, so unsorted inputs and alternating zones reuse them too. The
+ * previous CHARSXP is checked first, as consecutive elements usually share it.
+ */
+class sys_info_columns
+{
+  const bool has_begin_;
+  const bool has_end_;
+  const bool has_offset_;
+  const bool has_dst_;
+  const bool has_abbreviation_;
+
+  rclock::duration::seconds begin_;
+  rclock::duration::seconds end_;
+  rclock::duration::seconds offset_;
+  cpp11::writable::logicals dst_;
+  cpp11::writable::strings abbreviation_;
+
+  std::unordered_map<std::string, SEXP> abbrevs_;
+  std::string abbrev_last_;
+  SEXP abbrev_last_chr_;
+
+public:
+  explicit sys_info_columns(r_ssize size);
+  sys_info_columns(r_ssize size, const cpp11::logicals& columns);
+
+  void assign(const date::sys_info& info, r_ssize i);
+  void assign_na(r_ssize i);
+
+  cpp11::writable::list to_list();
+
+private:
+  sys_info_columns(r_ssize size,
+                   bool has_begin,
+                   bool has_end,
+                   bool has_offset,
+                   bool has_dst,
+                   bool has_abbreviation);
+
+  SEXP intern_abbrev(const std::string& abbrev);
+};
+
+// All columns
+inline
+sys_info_columns::sys_info_columns(r_ssize size)
+  : sys_info_columns(size, true, true, true, true, true)
+  {}
+
+inline
+sys_info_columns::sys_info_columns(r_ssize size, const cpp11::logicals& columns)
+  : sys_info_columns(
+      size,
+      static_cast<bool>(columns[0]),
+      static_cast<bool>(columns[1]),
+      static_cast<bool>(columns[2]),
+      static_cast<bool>(columns[3]),
+      static_cast<bool>(columns[4])
+    )
+  {}
+
+inline
+sys_info_columns::sys_info_columns(r_ssize size,
+                                   bool has_begin,
+                                   bool has_end,
+                                   bool has_offset,
+                                   bool has_dst,
+                                   bool has_abbreviation)
+  : has_begin_(has_begin),
+    has_end_(has_end),
+    has_offset_(has_offset),
+    has_dst_(has_dst),
+    has_abbreviation_(has_abbreviation),
+    begin_(has_begin_ ? size : 0),
+    end_(has_end_ ? size : 0),
+    offset_(has_offset_ ? size : 0),
+    dst_(has_dst_ ? size : 0),
+    abbreviation_(has_abbreviation_ ? size : 0),
+    abbrev_last_chr_(NULL)
+  {}
+
+inline
+void
+sys_info_columns::assign(const date::sys_info& info, r_ssize i) {
+  if (has_begin_) {
+    begin_.assign(info.begin.time_since_epoch(), i);
+  }
+  if (has_end_) {
+    end_.assign(info.end.time_since_epoch(), i);
+  }
+  if (has_offset_) {
+    offset_.assign(info.offset, i);
+  }
+  if (has_dst_) {
+    dst_[i] = info.save != std::chrono::minutes::zero();
+  }
+  if (has_abbreviation_) {
+    SET_STRING_ELT(abbreviation_, i, intern_abbrev(info.abbrev));
+  }
+}
+
+inline
+void
+sys_info_columns::assign_na(r_ssize i) {
+  if (has_begin_) {
+    begin_.assign_na(i);
+  }
+  if (has_end_) {
+    end_.assign_na(i);
+  }
+  if (has_offset_) {
+    offset_.assign_na(i);
+  }
+  if (has_dst_) {
+    dst_[i] = r_lgl_na;
+  }
+  if (has_abbreviation_) {
+    SET_STRING_ELT(abbreviation_, i, r_chr_na);
+  }
+}
+
+inline
+cpp11::writable::list
+sys_info_columns::to_list() {
+  const r_ssize n =
+    has_begin_ +
+    has_end_ +
+    has_offset_ +
+    has_dst_ +
+    has_abbreviation_;
+
+  cpp11::writable::list out(n);
+  cpp11::writable::strings names(n);
+
+  r_ssize i = 0;
+
+  if (has_begin_) {
+    out[i] = begin_.to_list();
+    names[i] = "begin";
+    ++i;
+  }
+  if (has_end_) {
+    out[i] = end_.to_list();
+    names[i] = "end";
+    ++i;
+  }
+  if (has_offset_) {
+    out[i] = offset_.to_list();
+    names[i] = "offset";
+    ++i;
+  }
+  if (has_dst_) {
+    out[i] = dst_;
+    names[i] = "dst";
+    ++i;
+  }
+  if (has_abbreviation_) {
+    out[i] = abbreviation_;
+    names[i] = "abbreviation";
+    ++i;
+  }
+
+  out.names() = names;
+
+  return out;
+}
+
+/*
+ * Every interned CHARSXP is protected by `abbreviation_`, as it is inserted
+ * into it right after being created.
+ */
+inline
+SEXP
+sys_info_columns::intern_abbrev(const std::string& abbrev) {
+  if (abbrev_last_chr_ != NULL && abbrev == abbrev_last_) {
+    return abbrev_last_chr_;
+  }
+
+  auto it = abbrevs_.find(abbrev);
+
+  if (it == abbrevs_.end()) {
+    const SEXP chr = Rf_mkCharLenCE(abbrev.c_str(), abbrev.size(), CE_UTF8);
+    it = abbrevs_.emplace(abbrev, chr).first;
+  }
+
+  abbrev_last_ = abbrev;
+  abbrev_last_chr_ = it->second;
+
+  return abbrev_last_chr_;
+}
+
+} // namespace rclock
+
+// -----------------------------------------------------------------------------
+
+#endif
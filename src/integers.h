@@ -5,17 +5,32 @@
 
 namespace rclock {
 
+/*
+ * A lazily copied integer vector.
+ *
+ * Raw pointers to the underlying data are resolved once, on construction and
+ * on the first write, so element access is a plain array access rather than a
+ * branch on `writable_` and a trip through a cpp11 proxy. ALTREP inputs are
+ * materialized through `INTEGER_RO()` up front, as repeated element access
+ * through ALTREP dispatch is much slower. ALTREP classes generally cache
+ * their materialized data, so wrapping the same input more than once only
+ * pays for this once.
+ */
 class integers
 {
   const cpp11::integers read_;
   cpp11::writable::integers write_;
   bool writable_;
   r_ssize size_;
+  const int* p_read_;
+  int* p_write_;
 
 public:
   integers() noexcept;
   integers(const cpp11::integers& x);
   integers(r_ssize size);
+  integers(const integers& x);
+  integers(integers&& x);
 
   bool is_na(r_ssize i) const noexcept;
   r_ssize size() const noexcept;
@@ -25,7 +40,14 @@ public:
 
   int operator[](r_ssize i) const noexcept;
 
+  const int* data() const noexcept;
+  int* data_writable();
+
   SEXP sexp() const noexcept;
+
+private:
+  void init_pointers();
+  void make_writable();
 };
 
 namespace detail {
@@ -38,28 +60,91 @@ inline
 integers::integers() noexcept
   : read_(detail::empty_integers),
     writable_(false),
-    size_(0)
+    size_(0),
+    p_read_(NULL),
+    p_write_(NULL)
   {}
 
 inline
 integers::integers(const cpp11::integers& x)
   : read_(x),
     writable_(false),
-    size_(x.size())
-  {}
+    size_(x.size()),
+    p_read_(NULL),
+    p_write_(NULL) {
+  init_pointers();
+}
 
 inline
 integers::integers(r_ssize size)
   : read_(detail::empty_integers),
     write_(cpp11::writable::integers(size)),
     writable_(true),
-    size_(size)
+    size_(size),
+    p_read_(NULL),
+    p_write_(NULL) {
+  init_pointers();
+}
+
+/*
+ * Copying a `cpp11::writable::integers` duplicates it, so the pointers have to
+ * be resolved again rather than copied
+ */
+inline
+integers::integers(const integers& x)
+  : read_(x.read_),
+    write_(x.write_),
+    writable_(x.writable_),
+    size_(x.size_),
+    p_read_(NULL),
+    p_write_(NULL) {
+  init_pointers();
+}
+
+inline
+integers::integers(integers&& x)
+  : read_(x.read_),
+    write_(std::move(x.write_)),
+    writable_(x.writable_),
+    size_(x.size_),
+    p_read_(x.p_read_),
+    p_write_(x.p_write_)
   {}
 
+inline
+void
+integers::init_pointers() {
+  if (writable_) {
+    p_write_ = INTEGER(write_);
+    p_read_ = p_write_;
+  } else if (size_ > 0) {
+    p_read_ = INTEGER_RO(read_);
+  }
+}
+
+/*
+ * The input is always copied before its first write, even if R doesn't seem
+ * to hold any other references to it. Inputs reach us through the closures in
+ * `cpp11.R`, whose promises hold their own reference, so `MAYBE_SHARED()` is
+ * always true by the time we get here. Even with a direct `.Call()`, the
+ * fields of a calendar or duration are shared with the object they were
+ * extracted from, and R doesn't decrement reference counts of list elements
+ * when the list itself becomes garbage. Only the fields that are actually
+ * written to are copied though, so `add_months()` only allocates new `year`
+ * and `month` fields and shares the rest with its input.
+ */
+inline
+void
+integers::make_writable() {
+  write_ = cpp11::writable::integers(read_);
+  writable_ = true;
+  init_pointers();
+}
+
 inline
 bool
 integers::is_na(r_ssize i) const noexcept {
-  return this->operator[](i) == r_int_na;
+  return p_read_[i] == r_int_na;
 }
 
 inline
@@ -72,10 +157,9 @@ inline
 void
 integers::assign(int x, r_ssize i) {
   if (!writable_) {
-    write_ = cpp11::writable::integers(read_);
-    writable_ = true;
+    make_writable();
   }
-  write_[i] = x;
+  p_write_[i] = x;
 }
 
 inline
@@ -87,7 +171,27 @@ integers::assign_na(r_ssize i) {
 inline
 int
 integers::operator[](r_ssize i) const noexcept {
-  return writable_ ? write_[i] : read_[i];
+  return p_read_[i];
+}
+
+/*
+ * Span style access for kernels that loop over a whole field at once. Resolve
+ * these once per kernel, outside of the loop. `data_writable()` makes the same
+ * lazy copy as `assign()`, and invalidates any previous `data()` pointer.
+ */
+inline
+const int*
+integers::data() const noexcept {
+  return p_read_;
+}
+
+inline
+int*
+integers::data_writable() {
+  if (!writable_) {
+    make_writable();
+  }
+  return p_write_;
 }
 
 inline
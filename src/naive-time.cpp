@@ -1,6 +1,8 @@
 #include "duration.h"
 #include "get.h"
 #include "zone.h"
+#include "zone-cursor.h"
+#include "info.h"
 #include "utils.h"
 
 // -----------------------------------------------------------------------------
@@ -10,7 +12,8 @@ static
 inline
 cpp11::writable::list
 naive_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
-                     const cpp11::strings& zone) {
+                     const cpp11::strings& zone,
+                     const cpp11::logicals& columns) {
   const ClockDuration x{fields};
   const r_ssize size = x.size();
   using Duration = typename ClockDuration::chrono_duration;
@@ -21,43 +24,24 @@ naive_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
   cpp11::r_string type_nonexistent{"nonexistent"};
   cpp11::r_string type_ambiguous{"ambiguous"};
 
-  rclock::duration::seconds first_begin(size);
-  rclock::duration::seconds first_end(size);
-  rclock::duration::seconds first_offset(size);
-  cpp11::writable::logicals first_dst(size);
-  cpp11::writable::strings first_abbreviation(size);
-
-  rclock::duration::seconds second_begin(size);
-  rclock::duration::seconds second_end(size);
-  rclock::duration::seconds second_offset(size);
-  cpp11::writable::logicals second_dst(size);
-  cpp11::writable::strings second_abbreviation(size);
-
-  const std::chrono::minutes zero{0};
+  rclock::sys_info_columns first(size, columns);
+  rclock::sys_info_columns second(size, columns);
 
   const bool recycle_zone = zone.size() == 1;
-  const date::time_zone* p_time_zone;
+  const date::time_zone* p_time_zone = NULL;
   if (recycle_zone) {
     const std::string zone_name = cpp11::r_string(zone[0]);
     p_time_zone = zone_name_load(zone_name);
   }
 
+  rclock::zone_cache cache;
+  rclock::zone_cursor cursor{p_time_zone};
+
   for (r_ssize i = 0; i < size; ++i) {
     if (x.is_na(i)) {
       SET_STRING_ELT(type, i, r_chr_na);
-
-      first_begin.assign_na(i);
-      first_end.assign_na(i);
-      first_offset.assign_na(i);
-      first_dst[i] = r_lgl_na;
-      SET_STRING_ELT(first_abbreviation, i, r_chr_na);
-
-      second_begin.assign_na(i);
-      second_end.assign_na(i);
-      second_offset.assign_na(i);
-      second_dst[i] = r_lgl_na;
-      SET_STRING_ELT(second_abbreviation, i, r_chr_na);
-
+      first.assign_na(i);
+      second.assign_na(i);
       continue;
     }
 
@@ -65,15 +49,13 @@ naive_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
     if (recycle_zone) {
       p_time_zone_elt = p_time_zone;
     } else {
-      const std::string zone_name_elt = cpp11::r_string(zone[i]);
-      p_time_zone_elt = zone_name_load(zone_name_elt);
+      p_time_zone_elt = cache.load(zone[i]);
     }
 
-    const date::local_time<Duration> elt{x[i]};
-    const date::local_info info = rclock::get_info(elt, p_time_zone_elt);
+    cursor.reset(p_time_zone_elt);
 
-    const date::sys_info first = info.first;
-    const date::sys_info second = info.second;
+    const date::local_time<Duration> elt{x[i]};
+    const date::local_info& info = cursor.get_info(elt);
 
     switch (info.result) {
     case date::local_info::unique: SET_STRING_ELT(type, i, type_unique); break;
@@ -82,53 +64,18 @@ naive_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
     default: never_reached("naive_time_info_impl");
     }
 
-    first_begin.assign(first.begin.time_since_epoch(), i);
-    first_end.assign(first.end.time_since_epoch(), i);
-    first_offset.assign(first.offset, i);
-    first_dst[i] = first.save != zero;
-    SET_STRING_ELT(first_abbreviation, i, Rf_mkCharLenCE(first.abbrev.c_str(), first.abbrev.size(), CE_UTF8));
+    first.assign(info.first, i);
 
     if (info.result == date::local_info::unique) {
       // date zero initializes `info.second` since there is no applicable information
-      second_begin.assign_na(i);
-      second_end.assign_na(i);
-      second_offset.assign_na(i);
-      second_dst[i] = r_lgl_na;
-      SET_STRING_ELT(second_abbreviation, i, r_chr_na);
+      second.assign_na(i);
     } else {
-      second_begin.assign(second.begin.time_since_epoch(), i);
-      second_end.assign(second.end.time_since_epoch(), i);
-      second_offset.assign(second.offset, i);
-      second_dst[i] = second.save != zero;
-      SET_STRING_ELT(second_abbreviation, i, Rf_mkCharLenCE(second.abbrev.c_str(), second.abbrev.size(), CE_UTF8));
+      second.assign(info.second, i);
     }
   }
 
-  cpp11::writable::list out_first_begin = first_begin.to_list();
-  cpp11::writable::list out_first_end = first_end.to_list();
-  cpp11::writable::list out_first_offset = first_offset.to_list();
-
-  cpp11::writable::list out_second_begin = second_begin.to_list();
-  cpp11::writable::list out_second_end = second_end.to_list();
-  cpp11::writable::list out_second_offset = second_offset.to_list();
-
-  cpp11::writable::list out_first = {
-    out_first_begin,
-    out_first_end,
-    out_first_offset,
-    first_dst,
-    first_abbreviation
-  };
-  out_first.names() = {"begin", "end", "offset", "dst", "abbreviation"};
-
-  cpp11::writable::list out_second = {
-    out_second_begin,
-    out_second_end,
-    out_second_offset,
-    second_dst,
-    second_abbreviation
-  };
-  out_second.names() = {"begin", "end", "offset", "dst", "abbreviation"};
+  cpp11::writable::list out_first = first.to_list();
+  cpp11::writable::list out_second = second.to_list();
 
   cpp11::writable::list out = {
     type,
@@ -144,15 +91,16 @@ naive_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
 cpp11::writable::list
 naive_time_info_cpp(cpp11::list_of<cpp11::doubles> fields,
                     const cpp11::integers& precision_int,
-                    const cpp11::strings& zone) {
+                    const cpp11::strings& zone,
+                    const cpp11::logicals& columns) {
   using namespace rclock;
 
   switch (parse_precision(precision_int)) {
-  case precision::day: return naive_time_info_impl<duration::days>(fields, zone);
-  case precision::second: return naive_time_info_impl<duration::seconds>(fields, zone);
-  case precision::millisecond: return naive_time_info_impl<duration::milliseconds>(fields, zone);
-  case precision::microsecond: return naive_time_info_impl<duration::microseconds>(fields, zone);
-  case precision::nanosecond: return naive_time_info_impl<duration::nanoseconds>(fields, zone);
+  case precision::day: return naive_time_info_impl<duration::days>(fields, zone, columns);
+  case precision::second: return naive_time_info_impl<duration::seconds>(fields, zone, columns);
+  case precision::millisecond: return naive_time_info_impl<duration::milliseconds>(fields, zone, columns);
+  case precision::microsecond: return naive_time_info_impl<duration::microseconds>(fields, zone, columns);
+  case precision::nanosecond: return naive_time_info_impl<duration::nanoseconds>(fields, zone, columns);
   default: clock_abort("Internal error: Should never be called.");
   }
 }
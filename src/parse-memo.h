@@ -0,0 +1,126 @@
+#ifndef CLOCK_PARSE_MEMO_H
+#define CLOCK_PARSE_MEMO_H
+
+#include "clock.h"
+#include "utils.h"
+#include <unordered_map>
+
+namespace rclock {
+
+/*
+ * Per-call memo of parse results, keyed by each element's CHARSXP
+ *
+ * Repeated strings share a CHARSXP thanks to R's global CHARSXP cache, so
+ * inputs like logs, with millions of rows but only thousands of distinct
+ * timestamps, only need to parse each distinct string once. Like
+ * `zone_cache`, this is only safe for the lifetime of the vector being parsed.
+ *
+ * `value` is whatever the caller needs to reproduce the result. `format` is
+ * the index of the format that parsed the string, or `-1` if it couldn't be
+ * parsed, so that repeats of a failure are recorded as failures too.
+ *
+ * Every `window` lookups, the memo checks how many of them were repeats. If
+ * fewer than a quarter were, the strings are mostly distinct, and the memo
+ * turns itself off for the rest of the call rather than paying for hashing
+ * and memory that it won't get back.
+ */
+template <class T>
+class parse_memo
+{
+public:
+  struct entry {
+    T value;
+    r_ssize format;
+  };
+
+private:
+  static const r_ssize window = 1024;
+
+  std::unordered_map<SEXP, entry> memo_;
+  SEXP last_;
+  const entry* p_last_;
+  bool enabled_;
+  r_ssize n_lookups_;
+  r_ssize n_repeats_;
+
+public:
+  parse_memo() noexcept;
+
+  const entry* find(SEXP x);
+  void insert(SEXP x, const T& value, r_ssize format);
+};
+
+template <class T>
+inline
+parse_memo<T>::parse_memo() noexcept
+  : last_(NULL),
+    p_last_(NULL),
+    enabled_(true),
+    n_lookups_(0),
+    n_repeats_(0)
+  {}
+
+/*
+ * The memoized result for `x`, or `NULL` if it hasn't been parsed yet or the
+ * memo is off
+ */
+template <class T>
+inline
+const typename parse_memo<T>::entry*
+parse_memo<T>::find(SEXP x) {
+  if (!enabled_) {
+    return NULL;
+  }
+
+  if (n_lookups_ == window) {
+    if (n_repeats_ < window / 4) {
+      enabled_ = false;
+      std::unordered_map<SEXP, entry>().swap(memo_);
+      last_ = NULL;
+      p_last_ = NULL;
+      return NULL;
+    }
+    n_lookups_ = 0;
+    n_repeats_ = 0;
+  }
+
+  ++n_lookups_;
+
+  // Repeats are often next to each other, like in sorted logs
+  if (x == last_) {
+    ++n_repeats_;
+    return p_last_;
+  }
+
+  auto it = memo_.find(x);
+
+  if (it == memo_.end()) {
+    return NULL;
+  }
+
+  ++n_repeats_;
+  last_ = x;
+  p_last_ = &it->second;
+
+  return p_last_;
+}
+
+template <class T>
+inline
+void
+parse_memo<T>::insert(SEXP x, const T& value, r_ssize format) {
+  if (!enabled_) {
+    return;
+  }
+
+  entry elt;
+  elt.value = value;
+  elt.format = format;
+
+  last_ = x;
+  p_last_ = &memo_.emplace(x, elt).first->second;
+}
+
+} // namespace rclock
+
+#endif
@@ -0,0 +1,1845 @@
+#ifndef CLOCK_PARSE_PROGRAM_H
+#define CLOCK_PARSE_PROGRAM_H
+
+#include "clock.h"
+#include "utils.h"
+#include "parse.h"
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <streambuf>
+#include <vector>
+
+// -----------------------------------------------------------------------------
+
+namespace rclock {
+
+namespace detail {
+
+enum class parse_op : unsigned char {
+  literal,
+  whitespace,
+  newline,
+  tab,
+  year,
+  year_unsigned,
+  century,
+  year_2,
+  iso_year,
+  iso_year_2,
+  month,
+  day,
+  day_of_year,
+  weekday_sunday,
+  weekday_monday,
+  week_sunday,
+  week_monday,
+  week_iso,
+  hour,
+  hour_12,
+  hour_12_unchecked,
+  minute,
+  second,
+  month_name,
+  weekday_name,
+  am_pm,
+  offset,
+  offset_colon,
+  abbrev
+};
+
+/*
+ * `c` is the character matched by `literal`. `width` is the maximum number of
+ * characters read by a numeric field, where `-1` means the default width for
+ * the precision of `second`.
+ */
+struct parse_instruction {
+  parse_op op;
+  char c;
+  int width;
+};
+
+/*
+ * A reader over a C string, following the same rules as the `std::istream`
+ * that `from_stream()` reads from. The end of the string acts as end of file.
+ *
+ * Like the stream, peeking at the end of the string sets `eof`, and any
+ * further peek fails, as the stream's sentry refuses to read once `eofbit` is
+ * set. This matters when a field stops at the end of the string and is
+ * followed by anything else in the format.
+ */
+class parse_reader
+{
+  const char* p_;
+  bool eof_;
+  bool fail_;
+
+public:
+  explicit parse_reader(const char* x) noexcept
+    : p_(x),
+      eof_(false),
+      fail_(false)
+    {}
+
+  bool fail() const noexcept { return fail_; }
+  bool good() const noexcept { return !fail_ && !eof_; }
+  void set_fail() noexcept { fail_ = true; }
+
+  // Like `peek()`, returns `false` at the end of the string
+  bool peek(char& c) noexcept {
+    if (eof_) {
+      fail_ = true;
+      return false;
+    }
+    if (*p_ == '\0') {
+      eof_ = true;
+      return false;
+    }
+    c = *p_;
+    return true;
+  }
+
+  void bump() noexcept { ++p_; }
+};
+
+// White space in the classic "C" locale, which the parsing streams use
+inline
+bool
+parse_is_space(char c) noexcept {
+  return c == ' ' || ('\t' <= c && c <= '\r');
+}
+
+inline
+bool
+parse_is_digit(char c) noexcept {
+  return '0' <= c && c <= '9';
+}
+
+// `date::detail::read(is, CharT)`
+inline
+void
+parse_read_char(parse_reader& reader, char x) {
+  char c;
+  if (!reader.peek(c) || c != x) {
+    reader.set_fail();
+    return;
+  }
+  reader.bump();
+}
+
+/*
+ * `std::ws()`, guarded by `is.good()` as it is for white space in the format.
+ * Composite directives call `ws()` unguarded, but it is always followed by a
+ * read that fails at the end of the string either way.
+ */
+inline
+void
+parse_read_whitespace(parse_reader& reader) {
+  if (!reader.good()) {
+    return;
+  }
+  char c;
+  while (reader.peek(c) && parse_is_space(c)) {
+    reader.bump();
+  }
+}
+
+// `date::detail::read_unsigned()`
+inline
+unsigned
+parse_read_unsigned(parse_reader& reader, unsigned m, unsigned M) {
+  unsigned x = 0;
+  unsigned count = 0;
+  char c;
+
+  while (reader.peek(c) && parse_is_digit(c)) {
+    reader.bump();
+    ++count;
+    x = 10 * x + static_cast<unsigned>(c - '0');
+    if (count == M) {
+      break;
+    }
+  }
+
+  if (count < m) {
+    reader.set_fail();
+  }
+
+  return x;
+}
+
+// `date::detail::read_signed()`, where the sign counts towards `M`
+inline
+int
+parse_read_signed(parse_reader& reader, unsigned m, unsigned M) {
+  char c;
+
+  if (reader.peek(c) && (parse_is_digit(c) || c == '-' || c == '+')) {
+    if (c == '-' || c == '+') {
+      reader.bump();
+      --M;
+    }
+    int x = static_cast<int>(parse_read_unsigned(reader, std::max(m, 1u), M));
+    if (!reader.fail()) {
+      return c == '-' ? -x : x;
+    }
+  }
+
+  if (m > 0) {
+    reader.set_fail();
+  }
+
+  return 0;
+}
+
+// `rclock::read_seconds()`
+inline
+long double
+parse_read_seconds(parse_reader& reader, char decimal_mark, unsigned m, unsigned M) {
+  unsigned count = 0;
+  unsigned fcount = 0;
+  unsigned long long i = 0;
+  unsigned long long f = 0;
+  bool parsing_fraction = false;
+  bool has_decimal_mark = true;
+  char c;
+
+  while (reader.peek(c)) {
+    if (has_decimal_mark && c == decimal_mark) {
+      has_decimal_mark = false;
+      parsing_fraction = true;
+    } else {
+      if (!parse_is_digit(c)) {
+        break;
+      }
+      if (!parsing_fraction) {
+        i = 10 * i + static_cast<unsigned>(c - '0');
+      } else {
+        f = 10 * f + static_cast<unsigned>(c - '0');
+        ++fcount;
+      }
+    }
+    reader.bump();
+    if (++count == M) {
+      break;
+    }
+  }
+
+  if (count < m) {
+    reader.set_fail();
+    return 0;
+  }
+
+  return static_cast<long double>(i) + static_cast<long double>(f) / std::pow(10.L, fcount);
+}
+
+/*
+ * `date::detail::scan_keyword()`. Case insensitively matches the longest of
+ * `[kb, ke)` and returns its offset from `kb`, or `ke - kb` on failure.
+ */
+inline
+std::ptrdiff_t
+parse_scan_keyword(parse_reader& reader, const std::string* kb, const std::string* ke) {
+  static const unsigned char doesnt_match = '\0';
+  static const unsigned char might_match = '\1';
+  static const unsigned char does_match = '\2';
+
+  // At most 24 month names
+  unsigned char status[24];
+
+  const std::ptrdiff_t nkw = ke - kb;
+  if (nkw > 24) {
+    clock_abort("Internal error: Too many names to match.");
+  }
+
+  std::ptrdiff_t n_might_match = nkw;
+  std::ptrdiff_t n_does_match = 0;
+
+  for (std::ptrdiff_t k = 0; k < nkw; ++k) {
+    if (!kb[k].empty()) {
+      status[k] = might_match;
+    } else {
+      status[k] = does_match;
+      --n_might_match;
+      ++n_does_match;
+    }
+  }
+
+  char ic;
+
+  for (std::size_t indx = 0; n_might_match > 0 && reader.peek(ic); ++indx) {
+    const char c = static_cast<char>(std::toupper(static_cast<unsigned char>(ic)));
+    bool consume = false;
+
+    for (std::ptrdiff_t k = 0; k < nkw; ++k) {
+      if (status[k] != might_match) {
+        continue;
+      }
+      if (c == static_cast<char>(std::toupper(static_cast<unsigned char>(kb[k][indx])))) {
+        consume = true;
+        if (kb[k].size() == indx + 1) {
+          status[k] = does_match;
+          --n_might_match;
+          ++n_does_match;
+        }
+      } else {
+        status[k] = doesnt_match;
+        --n_might_match;
+      }
+    }
+
+    if (consume) {
+      reader.bump();
+      if (n_might_match + n_does_match > 1) {
+        for (std::ptrdiff_t k = 0; k < nkw; ++k) {
+          if (status[k] == does_match && kb[k].size() != indx + 1) {
+            status[k] = doesnt_match;
+            --n_does_match;
+          }
+        }
+      }
+    }
+  }
+
+  for (std::ptrdiff_t k = 0; k < nkw; ++k) {
+    if (status[k] == does_match) {
+      return k;
+    }
+  }
+
+  reader.set_fail();
+  return nkw;
+}
+
+// Is `c` a valid time zone name or abbreviation character?
+inline
+bool
+parse_is_abbrev_char(char c) noexcept {
+  return '\1' < c && c < '\177' &&
+    (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '/' || c == '-' || c == '+');
+}
+
+// `date::detail::checked_set()`
+template <class T>
+inline
+void
+parse_checked_set(T& value, const T& from, const T& not_a_value, parse_reader& reader) {
+  if (reader.fail()) {
+    return;
+  }
+  if (value == not_a_value) {
+    value = from;
+  } else if (value != from) {
+    reader.set_fail();
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * The outcome of the ISO 8601 fast path. `fallback` means the string isn't in
+ * the canonical layout, and the general program has to decide.
+ */
+enum class iso_status {
+  parsed,
+  failed,
+  fallback
+};
+
+/*
+ * Read a field of exactly `n` digits at `p`, advancing `p` past it. A field
+ * with no digits fails, as it does in `read_unsigned()`. A field with fewer
+ * than `n` digits is valid, but is left to the general program.
+ */
+inline
+iso_status
+iso_read_field(const char*& p, int n, int& value) noexcept {
+  int out = 0;
+
+  for (int i = 0; i < n; ++i) {
+    const unsigned digit = static_cast<unsigned>(static_cast<unsigned char>(p[i])) - '0';
+    if (digit > 9) {
+      return i == 0 ? iso_status::failed : iso_status::fallback;
+    }
+    out = 10 * out + static_cast<int>(digit);
+  }
+
+  p += n;
+  value = out;
+  return iso_status::parsed;
+}
+
+} // namespace detail
+
+// -----------------------------------------------------------------------------
+
+namespace detail {
+
+/*
+ * A piece of the language that a program accepts: between `min` and `max`
+ * characters from `chars`, where `max == -1` means there is no limit. A
+ * program's pieces, followed by anything at all, describe a superset of the
+ * strings it can parse.
+ */
+struct parse_piece {
+  std::bitset<256> chars;
+  int min;
+  int max;
+};
+
+/*
+ * Could any string match both `x` and `y`? Walks the product of their
+ * automatons, where a state is a piece and the number of characters read from
+ * it so far. Reaching the end of either means the other can be completed with
+ * some string, which the first accepts too.
+ */
+inline
+bool
+parse_pieces_overlap(const std::vector<parse_piece>& x, const std::vector<parse_piece>& y) {
+  // Number of characters read from a piece is capped at `max`, or at `min`
+  // when there is no limit
+  struct automaton {
+    const std::vector<parse_piece>& pieces;
+    std::vector<int> offsets;
+    int final;
+
+    explicit automaton(const std::vector<parse_piece>& x) : pieces(x) {
+      int offset = 0;
+      for (const parse_piece& piece : pieces) {
+        offsets.push_back(offset);
+        offset += (piece.max == -1 ? piece.min : piece.max) + 1;
+      }
+      final = offset;
+    }
+
+    int state(std::size_t piece, int count) const {
+      return piece == pieces.size() ? final : offsets[piece] + count;
+    }
+    bool can_read(std::size_t piece, int count) const {
+      return pieces[piece].max == -1 || count < pieces[piece].max;
+    }
+    bool can_skip(std::size_t piece, int count) const {
+      return count >= pieces[piece].min;
+    }
+    int next_count(std::size_t piece, int count) const {
+      const parse_piece& elt = pieces[piece];
+      return elt.max == -1 ? std::min(count + 1, elt.min) : count + 1;
+    }
+  };
+
+  const automaton ax{x};
+  const automaton ay{y};
+
+  struct pair {
+    std::size_t x_piece;
+    int x_count;
+    std::size_t y_piece;
+    int y_count;
+  };
+
+  std::vector<char> visited(static_cast<std::size_t>(ax.final + 1) * static_cast<std::size_t>(ay.final + 1), 0);
+  std::vector<pair> stack;
+
+  auto push = [&](std::size_t x_piece, int x_count, std::size_t y_piece, int y_count) {
+    const std::size_t id =
+      static_cast<std::size_t>(ax.state(x_piece, x_count)) * static_cast<std::size_t>(ay.final + 1) +
+      static_cast<std::size_t>(ay.state(y_piece, y_count));
+    if (!visited[id]) {
+      visited[id] = 1;
+      stack.push_back(pair{x_piece, x_count, y_piece, y_count});
+    }
+  };
+
+  push(0, 0, 0, 0);
+
+  while (!stack.empty()) {
+    const pair elt = stack.back();
+    stack.pop_back();
+
+    if (elt.x_piece == x.size() || elt.y_piece == y.size()) {
+      return true;
+    }
+
+    if (ax.can_skip(elt.x_piece, elt.x_count)) {
+      push(elt.x_piece + 1, 0, elt.y_piece, elt.y_count);
+    }
+    if (ay.can_skip(elt.y_piece, elt.y_count)) {
+      push(elt.x_piece, elt.x_count, elt.y_piece + 1, 0);
+    }
+    if (ax.can_read(elt.x_piece, elt.x_count) &&
+        ay.can_read(elt.y_piece, elt.y_count) &&
+        (x[elt.x_piece].chars & y[elt.y_piece].chars).any()) {
+      push(
+        elt.x_piece,
+        ax.next_count(elt.x_piece, elt.x_count),
+        elt.y_piece,
+        ay.next_count(elt.y_piece, elt.y_count)
+      );
+    }
+  }
+
+  return false;
+}
+
+// A read only `std::streambuf` over characters owned by someone else
+class span_streambuf : public std::streambuf
+{
+public:
+  void reset(const char* begin, const char* end) {
+    char* p_begin = const_cast<char*>(begin);
+    char* p_end = const_cast<char*>(end);
+    setg(p_begin, p_begin, p_end);
+  }
+};
+
+} // namespace detail
+
+/*
+ * The stream that `parse_program::parse()` falls back to `from_stream()`
+ * with. It reads each element in place, so nothing is copied, and it is only
+ * pointed at an element when a format couldn't be compiled. Create one per
+ * call and reuse it for every element, as constructing a stream isn't cheap.
+ */
+class parse_stream
+{
+  detail::span_streambuf buf_;
+  std::istream stream_;
+
+public:
+  parse_stream()
+    : buf_(),
+      stream_(&buf_)
+    {}
+
+  parse_stream(const parse_stream&) = delete;
+  parse_stream& operator=(const parse_stream&) = delete;
+
+  std::istream& reset(const char* x) {
+    buf_.reset(x, x + std::strlen(x));
+    stream_.clear();
+    return stream_;
+  }
+};
+
+// -----------------------------------------------------------------------------
+
+/*
+ * A format string compiled into a program
+ *
+ * `from_stream()` interprets its format string character by character, and
+ * reads through an `std::istream`, for every element and every format. A
+ * `parse_program` compiles its format once per call into a sequence of
+ * instructions: literal characters, white space, numeric fields with their
+ * widths resolved, name tables, and `%z` / `%Z` handlers. `parse()` then runs
+ * them directly against the element's C string.
+ *
+ * Programs read with the same rules as `from_stream()` and share its
+ * `resolve_fields()` and `finish_parse()` steps, so results are identical.
+ * Formats that can't be compiled, like ones with unknown directives or
+ * modifiers that `from_stream()` reads literally, fall back to
+ * `from_stream()`.
+ *
+ * Programs for ISO 8601 layouts, which include the default formats of most
+ * parsing functions, first try `run_iso()`. See `match_iso()`.
+ *
+ * The format and names are referenced, not copied, so they must outlive the
+ * program.
+ */
+class parse_program
+{
+  const char* fmt_;
+  std::pair<const std::string*, const std::string*> month_names_pair_;
+  std::pair<const std::string*, const std::string*> weekday_names_pair_;
+  std::pair<const std::string*, const std::string*> ampm_names_pair_;
+  char decimal_mark_;
+  std::vector<detail::parse_instruction> instructions_;
+  bool compiled_;
+  bool iso_;
+
+public:
+  parse_program(const std::string& fmt,
+                const std::pair<const std::string*, const std::string*>& month_names_pair,
+                const std::pair<const std::string*, const std::string*>& weekday_names_pair,
+                const std::pair<const std::string*, const std::string*>& ampm_names_pair,
+                const char& decimal_mark);
+
+  bool compiled() const noexcept;
+  bool excludes(const parse_program& other) const;
+
+  template <class... Args>
+  bool parse(parse_stream& stream, const char* x, Args&&... args) const;
+
+private:
+  bool compile();
+  void push(detail::parse_op op, char c = '\0', int width = -1);
+  bool match_iso() const;
+  std::vector<detail::parse_piece> pieces() const;
+
+  template <class Duration>
+  detail::iso_status run_iso(const char* x,
+                             date::fields<Duration>& fds,
+                             std::string* abbrev,
+                             std::chrono::minutes* offset) const;
+
+  template <class Duration>
+  bool run(const char* x,
+           date::fields<Duration>& fds,
+           std::string* abbrev,
+           std::chrono::minutes* offset) const;
+
+  template <class Duration>
+  bool run(const char* x,
+           date::sys_time<Duration>& tp,
+           std::string* abbrev = nullptr,
+           std::chrono::minutes* offset = nullptr) const;
+
+  template <class Duration>
+  bool run(const char* x,
+           date::local_time<Duration>& tp,
+           std::string* abbrev = nullptr,
+           std::chrono::minutes* offset = nullptr) const;
+
+  bool run(const char* x,
+           date::year& y,
+           std::string* abbrev = nullptr,
+           std::chrono::minutes* offset = nullptr) const;
+
+  bool run(const char* x,
+           date::year_month& ym,
+           std::string* abbrev = nullptr,
+           std::chrono::minutes* offset = nullptr) const;
+
+  template <class Duration>
+  bool run(const char* x,
+           date::year_month_day& ymd,
+           date::hh_mm_ss<Duration>& tod,
+           std::string* abbrev = nullptr,
+           std::chrono::minutes* offset = nullptr) const;
+
+  bool run(const char* x,
+           date::year_month_day& ymd,
+           std::string* abbrev = nullptr,
+           std::chrono::minutes* offset = nullptr) const;
+};
+
+inline
+parse_program::parse_program(const std::string& fmt,
+                             const std::pair<const std::string*, const std::string*>& month_names_pair,
+                             const std::pair<const std::string*, const std::string*>& weekday_names_pair,
+                             const std::pair<const std::string*, const std::string*>& ampm_names_pair,
+                             const char& decimal_mark)
+  : fmt_(fmt.c_str()),
+    month_names_pair_(month_names_pair),
+    weekday_names_pair_(weekday_names_pair),
+    ampm_names_pair_(ampm_names_pair),
+    decimal_mark_(decimal_mark) {
+  compiled_ = compile();
+  if (!compiled_) {
+    instructions_.clear();
+  }
+  iso_ = compiled_ && match_iso();
+}
+
+inline
+bool
+parse_program::compiled() const noexcept {
+  return compiled_;
+}
+
+/*
+ * Is there no string that both this program and `other` can parse? Formats
+ * that couldn't be compiled are never known to exclude anything.
+ */
+inline
+bool
+parse_program::excludes(const parse_program& other) const {
+  if (!compiled_ || !other.compiled_) {
+    return false;
+  }
+  return !detail::parse_pieces_overlap(pieces(), other.pieces());
+}
+
+/*
+ * Parse `x` into `args`, which are the same outputs that `from_stream()`
+ * takes. `stream` is only used if the format couldn't be compiled.
+ */
+template <class... Args>
+inline
+bool
+parse_program::parse(parse_stream& stream, const char* x, Args&&... args) const {
+  if (compiled_) {
+    return run(x, std::forward<Args>(args)...);
+  }
+
+  std::istream& is = stream.reset(x);
+
+  rclock::from_stream(
+    is,
+    fmt_,
+    month_names_pair_,
+    weekday_names_pair_,
+    ampm_names_pair_,
+    decimal_mark_,
+    std::forward<Args>(args)...
+  );
+
+  return !is.fail();
+}
+
+inline
+void
+parse_program::push(detail::parse_op op, char c, int width) {
+  detail::parse_instruction instruction;
+  instruction.op = op;
+  instruction.c = c;
+  instruction.width = width;
+  instructions_.push_back(instruction);
+}
+
+/*
+ * Can `run_iso()` run this program? That is, is it `%Y`, optionally followed
+ * by `-%m`, `-%d`, any separator and `%H`, `:%M`, and `:%S` in that order, all
+ * at their default widths, and then by any mix of literals, white space, and
+ * at most one each of `%z` and `%Z`. This covers `%F`, `%T`, RFC 3339, and the
+ * default formats of the parsing functions.
+ */
+inline
+bool
+parse_program::match_iso() const {
+  using detail::parse_op;
+  using detail::parse_instruction;
+
+  // `'\0'` allows any literal or white space as the separator
+  static const char separators[] = {'-', '-', '\0', ':', ':'};
+  static const parse_op fields[] = {
+    parse_op::month,
+    parse_op::day,
+    parse_op::hour,
+    parse_op::minute,
+    parse_op::second
+  };
+
+  const std::size_t size = instructions_.size();
+
+  if (size == 0 || instructions_[0].op != parse_op::year || instructions_[0].width != 4) {
+    return false;
+  }
+
+  std::size_t i = 1;
+
+  for (int k = 0; k < 5 && i + 1 < size; ++k, i += 2) {
+    const parse_instruction& separator = instructions_[i];
+    const parse_instruction& field = instructions_[i + 1];
+
+    const bool separator_ok = separators[k] == '\0' ?
+      separator.op == parse_op::literal || separator.op == parse_op::whitespace :
+      separator.op == parse_op::literal && separator.c == separators[k];
+
+    const int width = fields[k] == parse_op::second ? -1 : 2;
+
+    if (!separator_ok || field.op != fields[k] || field.width != width) {
+      break;
+    }
+  }
+
+  int n_offset = 0;
+  int n_abbrev = 0;
+
+  for (; i < size; ++i) {
+    switch (instructions_[i].op) {
+    case parse_op::literal:
+    case parse_op::whitespace: {
+      break;
+    }
+    case parse_op::offset:
+    case parse_op::offset_colon: {
+      if (++n_offset > 1) return false;
+      break;
+    }
+    case parse_op::abbrev: {
+      if (++n_abbrev > 1) return false;
+      break;
+    }
+    default: {
+      return false;
+    }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Walks the format with the same state machine as `from_stream()`. Returns
+ * `false` for anything that `from_stream()` would read literally, like unknown
+ * directives, unsupported modifiers, or a trailing `%`.
+ */
+inline
+bool
+parse_program::compile() {
+  using detail::parse_op;
+
+  const char* fmt = fmt_;
+  bool command = false;
+  char modified = '\0';
+  int width = -1;
+
+  for (; *fmt != '\0'; ++fmt) {
+    const char c = *fmt;
+
+    if (!command) {
+      if (c == '%') {
+        command = true;
+      } else if (detail::parse_is_space(c)) {
+        push(parse_op::whitespace);
+      } else {
+        push(parse_op::literal, c);
+      }
+      continue;
+    }
+
+    const bool unmodified = modified == '\0';
+    const bool not_E = modified != 'E';
+    const bool not_O = modified != 'O';
+
+    switch (c) {
+    case 'E':
+    case 'O': {
+      if (!unmodified) {
+        return false;
+      }
+      modified = c;
+      continue;
+    }
+    case 'a':
+    case 'A': {
+      if (!unmodified) return false;
+      push(parse_op::weekday_name);
+      break;
+    }
+    case 'u':
+    case 'w': {
+      if (!not_E) return false;
+      push(c == 'u' ? parse_op::weekday_monday : parse_op::weekday_sunday, '\0', width == -1 ? 1 : width);
+      break;
+    }
+    case 'b':
+    case 'B':
+    case 'h': {
+      if (!unmodified) return false;
+      push(parse_op::month_name);
+      break;
+    }
+    case 'c': {
+      // "%a %b %e %T %Y"
+      if (!not_O) return false;
+      push(parse_op::weekday_name);
+      push(parse_op::whitespace);
+      push(parse_op::month_name);
+      push(parse_op::whitespace);
+      push(parse_op::day, '\0', 2);
+      push(parse_op::whitespace);
+      push(parse_op::hour, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::minute, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::second);
+      push(parse_op::whitespace);
+      push(parse_op::year_unsigned, '\0', 4);
+      break;
+    }
+    case 'x':
+    case 'D': {
+      // "%m/%d/%y"
+      if (c == 'x' ? !not_O : !unmodified) return false;
+      push(parse_op::month, '\0', 2);
+      push(parse_op::literal, '/');
+      push(parse_op::day, '\0', 2);
+      push(parse_op::literal, '/');
+      push(parse_op::year_2, '\0', 2);
+      break;
+    }
+    case 'X':
+    case 'T': {
+      // "%H:%M:%S"
+      if (c == 'X' ? !not_O : !unmodified) return false;
+      push(parse_op::hour, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::minute, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::second);
+      break;
+    }
+    case 'C': {
+      push(parse_op::century, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'F': {
+      // "%Y-%m-%d"
+      if (!unmodified) return false;
+      push(parse_op::year, '\0', width == -1 ? 4 : width);
+      push(parse_op::literal, '-');
+      push(parse_op::month, '\0', 2);
+      push(parse_op::literal, '-');
+      push(parse_op::day, '\0', 2);
+      break;
+    }
+    case 'd':
+    case 'e': {
+      if (!not_E) return false;
+      push(parse_op::day, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'H': {
+      if (!not_E) return false;
+      push(parse_op::hour, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'I': {
+      if (!unmodified) return false;
+      push(parse_op::hour_12, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'j': {
+      if (!unmodified) return false;
+      push(parse_op::day_of_year, '\0', width == -1 ? 3 : width);
+      break;
+    }
+    case 'M': {
+      if (!not_E) return false;
+      push(parse_op::minute, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'm': {
+      if (!not_E) return false;
+      push(parse_op::month, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'n': {
+      if (!unmodified) return false;
+      push(parse_op::newline);
+      break;
+    }
+    case 't': {
+      if (!unmodified) return false;
+      // At the end of the input, `from_stream()` doesn't leave command mode
+      // after `%t`, so the rest of the format is read differently. Only
+      // `%t` at the end of the format, or followed by something that
+      // can't match at the end of the input anyways, is compiled.
+      const char next = fmt[1];
+      if (next == 't' || next == 'E' || next == 'O' || detail::parse_is_digit(next)) {
+        return false;
+      }
+      push(parse_op::tab);
+      break;
+    }
+    case 'p': {
+      if (!unmodified) return false;
+      push(parse_op::am_pm);
+      break;
+    }
+    case 'r': {
+      // "%I:%M:%S %p"
+      if (!unmodified) return false;
+      push(parse_op::hour_12_unchecked, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::minute, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::second);
+      push(parse_op::whitespace);
+      push(parse_op::am_pm);
+      break;
+    }
+    case 'R': {
+      // "%H:%M"
+      if (!unmodified) return false;
+      push(parse_op::hour, '\0', 2);
+      push(parse_op::literal, ':');
+      push(parse_op::minute, '\0', 2);
+      break;
+    }
+    case 'S': {
+      if (!not_E) return false;
+      push(parse_op::second, '\0', width);
+      break;
+    }
+    case 'Y': {
+      if (!not_O) return false;
+      push(parse_op::year, '\0', width == -1 ? 4 : width);
+      break;
+    }
+    case 'y': {
+      push(parse_op::year_2, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'g': {
+      if (!unmodified) return false;
+      push(parse_op::iso_year_2, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case 'G': {
+      if (!unmodified) return false;
+      push(parse_op::iso_year, '\0', width == -1 ? 4 : width);
+      break;
+    }
+    case 'U':
+    case 'V':
+    case 'W': {
+      if (!unmodified) return false;
+      const parse_op op =
+        c == 'U' ? parse_op::week_sunday :
+        c == 'W' ? parse_op::week_monday :
+        parse_op::week_iso;
+      push(op, '\0', width == -1 ? 2 : width);
+      break;
+    }
+    case '%': {
+      if (!unmodified) return false;
+      push(parse_op::literal, '%');
+      break;
+    }
+    case 'z': {
+      push(unmodified ? parse_op::offset : parse_op::offset_colon);
+      break;
+    }
+    case 'Z': {
+      if (!unmodified) return false;
+      push(parse_op::abbrev);
+      break;
+    }
+    default: {
+      if (width == -1 && unmodified && detail::parse_is_digit(c)) {
+        width = c - '0';
+        while (detail::parse_is_digit(fmt[1])) {
+          width = 10 * width + (*++fmt - '0');
+        }
+        continue;
+      }
+      return false;
+    }
+    }
+
+    command = false;
+    modified = '\0';
+    width = -1;
+  }
+
+  // A trailing `%`, modifier, or width
+  return !command;
+}
+
+/*
+ * The language of a compiled program, loosely. Each instruction becomes the
+ * characters it can read and how many of them, ignoring finer rules like the
+ * values of fields or the names themselves. A width of `0`, or a sign
+ * followed by a width of `1`, leaves a numeric field unbounded, as it does in
+ * `read_unsigned()`.
+ */
+inline
+std::vector<detail::parse_piece>
+parse_program::pieces() const {
+  using detail::parse_op;
+  using detail::parse_piece;
+
+  std::bitset<256> spaces;
+  std::bitset<256> digits;
+  std::bitset<256> signs;
+  std::bitset<256> abbrevs;
+
+  for (int i = 0; i < 256; ++i) {
+    const char c = static_cast<char>(i);
+    spaces[i] = detail::parse_is_space(c);
+    digits[i] = detail::parse_is_digit(c);
+    signs[i] = c == '+' || c == '-';
+    abbrevs[i] = detail::parse_is_abbrev_char(c);
+  }
+
+  // Characters that `parse_scan_keyword()` can match, case insensitively
+  auto names = [](const std::pair<const std::string*, const std::string*>& pair) {
+    parse_piece out{std::bitset<256>{}, 1, 0};
+    std::bitset<256> upper;
+
+    for (const std::string* name = pair.first; name != pair.second; ++name) {
+      if (name->empty()) {
+        out.min = 0;
+      }
+      out.max = std::max(out.max, static_cast<int>(name->size()));
+      for (const char c : *name) {
+        upper[std::toupper(static_cast<unsigned char>(c))] = true;
+      }
+    }
+    for (int i = 0; i < 256; ++i) {
+      out.chars[i] = upper[std::toupper(i)];
+    }
+
+    return out;
+  };
+
+  std::vector<parse_piece> out;
+
+  for (const detail::parse_instruction& instruction : instructions_) {
+    const int width = instruction.width;
+
+    switch (instruction.op) {
+    case parse_op::literal: {
+      std::bitset<256> chars;
+      chars[static_cast<unsigned char>(instruction.c)] = true;
+      out.push_back(parse_piece{chars, 1, 1});
+      break;
+    }
+    case parse_op::whitespace: {
+      out.push_back(parse_piece{spaces, 0, -1});
+      break;
+    }
+    case parse_op::newline: {
+      out.push_back(parse_piece{spaces, 1, 1});
+      break;
+    }
+    case parse_op::tab: {
+      out.push_back(parse_piece{spaces, 0, 1});
+      break;
+    }
+    case parse_op::year:
+    case parse_op::century:
+    case parse_op::iso_year: {
+      out.push_back(parse_piece{signs, 0, 1});
+      out.push_back(parse_piece{digits, 1, width > 1 ? width : -1});
+      break;
+    }
+    case parse_op::second: {
+      std::bitset<256> chars = digits;
+      chars[static_cast<unsigned char>(decimal_mark_)] = true;
+      out.push_back(parse_piece{chars, 1, width > 0 ? width : -1});
+      break;
+    }
+    case parse_op::month_name: {
+      out.push_back(names(month_names_pair_));
+      break;
+    }
+    case parse_op::weekday_name: {
+      out.push_back(names(weekday_names_pair_));
+      break;
+    }
+    case parse_op::am_pm: {
+      out.push_back(names(ampm_names_pair_));
+      break;
+    }
+    case parse_op::offset:
+    case parse_op::offset_colon: {
+      std::bitset<256> chars = digits;
+      chars[static_cast<unsigned char>(':')] = true;
+      out.push_back(parse_piece{signs, 0, 1});
+      out.push_back(parse_piece{chars, 1, 5});
+      break;
+    }
+    case parse_op::abbrev: {
+      out.push_back(parse_piece{abbrevs, 1, -1});
+      break;
+    }
+    default: {
+      out.push_back(parse_piece{digits, 1, width > 0 ? width : -1});
+      break;
+    }
+    }
+  }
+
+  return out;
+}
+
+/*
+ * The counterpart to the core `from_stream()`
+ */
+template <class Duration>
+inline
+bool
+parse_program::run(const char* x,
+                   date::fields<Duration>& fds,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  using detail::parse_op;
+  using detail::parse_checked_set;
+  using std::chrono::hours;
+  using std::chrono::minutes;
+
+  using dfs = date::detail::decimal_format_seconds<Duration>;
+  CONSTDATA auto w = Duration::period::den == 1 ? 2 : 3 + dfs::width;
+
+  if (iso_) {
+    switch (run_iso(x, fds, abbrev, offset)) {
+    case detail::iso_status::parsed: return true;
+    case detail::iso_status::failed: return false;
+    case detail::iso_status::fallback: break;
+    }
+  }
+
+  detail::parse_fields<Duration, std::string> parsed{};
+  detail::parse_reader reader{x};
+
+  const detail::parse_instruction* it = instructions_.data();
+  const detail::parse_instruction* end = it + instructions_.size();
+
+  for (; it != end; ++it) {
+    const unsigned width = static_cast<unsigned>(it->width);
+
+    switch (it->op) {
+    case parse_op::literal: {
+      detail::parse_read_char(reader, it->c);
+      break;
+    }
+    case parse_op::whitespace: {
+      detail::parse_read_whitespace(reader);
+      break;
+    }
+    case parse_op::newline:
+    case parse_op::tab: {
+      // %n matches a single white space character
+      // %t matches 0 or 1 white space characters
+      char c;
+      if (!reader.peek(c)) {
+        if (it->op == parse_op::newline || it + 1 != end) {
+          reader.set_fail();
+        }
+      } else if (detail::parse_is_space(c)) {
+        reader.bump();
+      } else if (it->op == parse_op::newline) {
+        reader.set_fail();
+      }
+      break;
+    }
+    case parse_op::year: {
+      const int value = detail::parse_read_signed(reader, 1, width);
+      parse_checked_set(parsed.Y, value, detail::not_a_year, reader);
+      break;
+    }
+    case parse_op::year_unsigned: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.Y, value, detail::not_a_year, reader);
+      break;
+    }
+    case parse_op::century: {
+      const int value = detail::parse_read_signed(reader, 1, width);
+      parse_checked_set(parsed.C, value, detail::not_a_century, reader);
+      break;
+    }
+    case parse_op::year_2: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.y, value, detail::not_a_2digit_year, reader);
+      break;
+    }
+    case parse_op::iso_year: {
+      const int value = detail::parse_read_signed(reader, 1, width);
+      parse_checked_set(parsed.G, value, detail::not_a_year, reader);
+      break;
+    }
+    case parse_op::iso_year_2: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.g, value, detail::not_a_2digit_year, reader);
+      break;
+    }
+    case parse_op::month: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.m, value, detail::not_a_month, reader);
+      break;
+    }
+    case parse_op::day: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.d, value, detail::not_a_day, reader);
+      break;
+    }
+    case parse_op::day_of_year: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.j, value, detail::not_a_doy, reader);
+      break;
+    }
+    case parse_op::weekday_sunday:
+    case parse_op::weekday_monday: {
+      int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      if (reader.fail()) {
+        break;
+      }
+      if (it->op == parse_op::weekday_monday) {
+        if (!(1 <= value && value <= 7)) {
+          reader.set_fail();
+          break;
+        }
+        if (value == 7) {
+          value = 0;
+        }
+      } else if (!(0 <= value && value <= 6)) {
+        reader.set_fail();
+        break;
+      }
+      parse_checked_set(parsed.wd, value, detail::not_a_weekday, reader);
+      break;
+    }
+    case parse_op::week_sunday: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.U, value, detail::not_a_week_num, reader);
+      break;
+    }
+    case parse_op::week_monday: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.W, value, detail::not_a_week_num, reader);
+      break;
+    }
+    case parse_op::week_iso: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.V, value, detail::not_a_week_num, reader);
+      break;
+    }
+    case parse_op::hour: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.H, value, detail::not_a_hour, reader);
+      break;
+    }
+    case parse_op::hour_12:
+    case parse_op::hour_12_unchecked: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      if (it->op == parse_op::hour_12 && !(1 <= value && value <= 12)) {
+        reader.set_fail();
+      }
+      parse_checked_set(parsed.I, value, detail::not_a_hour_12_value, reader);
+      break;
+    }
+    case parse_op::minute: {
+      const int value = static_cast<int>(detail::parse_read_unsigned(reader, 1, width));
+      parse_checked_set(parsed.M, value, detail::not_a_minute, reader);
+      break;
+    }
+    case parse_op::second: {
+      const unsigned M = it->width == -1 ? static_cast<unsigned>(w) : width;
+      const long double S = detail::parse_read_seconds(reader, decimal_mark_, 1, M);
+      if (reader.fail()) {
+        break;
+      }
+      const Duration value = date::detail::round_i<Duration>(std::chrono::duration<long double>{S});
+      parse_checked_set(parsed.s, value, Duration::min(), reader);
+      break;
+    }
+    case parse_op::month_name: {
+      const std::ptrdiff_t i = detail::parse_scan_keyword(reader, month_names_pair_.first, month_names_pair_.second);
+      const int value = static_cast<int>(i % 12 + 1);
+      parse_checked_set(parsed.m, value, detail::not_a_month, reader);
+      break;
+    }
+    case parse_op::weekday_name: {
+      const std::ptrdiff_t i = detail::parse_scan_keyword(reader, weekday_names_pair_.first, weekday_names_pair_.second);
+      const int value = static_cast<int>(i % 7);
+      parse_checked_set(parsed.wd, value, detail::not_a_weekday, reader);
+      break;
+    }
+    case parse_op::am_pm: {
+      const std::ptrdiff_t i = detail::parse_scan_keyword(reader, ampm_names_pair_.first, ampm_names_pair_.second);
+      const int value = static_cast<int>(i);
+      parse_checked_set(parsed.p, value, detail::not_a_ampm, reader);
+      break;
+    }
+    case parse_op::offset:
+    case parse_op::offset_colon: {
+      minutes toff = detail::not_a_offset;
+      bool neg = false;
+      char c;
+
+      if (reader.peek(c)) {
+        if (c == '-') {
+          neg = true;
+          reader.bump();
+        } else if (c == '+') {
+          reader.bump();
+        }
+      }
+
+      const bool colon = it->op == parse_op::offset_colon;
+
+      const int tH = static_cast<int>(detail::parse_read_unsigned(reader, colon ? 1 : 2, 2));
+      if (reader.fail()) {
+        break;
+      }
+      toff = hours{std::abs(tH)};
+
+      if (reader.good() && reader.peek(c)) {
+        if (colon && c == ':') {
+          reader.bump();
+          const int tM = static_cast<int>(detail::parse_read_unsigned(reader, 2, 2));
+          if (!reader.fail()) {
+            toff += minutes{tM};
+          }
+        } else if (!colon && detail::parse_is_digit(c)) {
+          const int tM = static_cast<int>(detail::parse_read_unsigned(reader, 2, 2));
+          if (!reader.fail()) {
+            toff += minutes{tM};
+          }
+        }
+      }
+
+      if (neg && !reader.fail()) {
+        toff = -toff;
+      }
+      parse_checked_set(parsed.offset, toff, detail::not_a_offset, reader);
+      break;
+    }
+    case parse_op::abbrev: {
+      std::string buf;
+      char c;
+      while (reader.peek(c) && detail::parse_is_abbrev_char(c)) {
+        buf.push_back(c);
+        reader.bump();
+      }
+      if (buf.empty()) {
+        reader.set_fail();
+      }
+      parse_checked_set(parsed.abbrev, buf, std::string(), reader);
+      break;
+    }
+    }
+
+    if (reader.fail()) {
+      return false;
+    }
+  }
+
+  return detail::resolve_fields(parsed, fds, abbrev, offset);
+}
+
+/*
+ * The fast path for programs that `match_iso()`
+ *
+ * Fields are read at exactly their maximum width straight from `x`, which is
+ * where the general program stops reading them too, so no field needs to look
+ * past its last digit. Any string that isn't in this canonical layout, like
+ * one with a signed year or a single digit month, returns `fallback` for the
+ * general program to handle. Anything the general program would reject for
+ * certain, like a mismatched literal, fails right away, so multiple formats
+ * don't pay for two attempts.
+ *
+ * Fractional seconds are exact in `Duration`, as no more digits are read than
+ * it can hold, so they are accumulated as integers rather than rounded from a
+ * `long double`. The fields are resolved the way `resolve_fields()` resolves
+ * them, except that the weekday isn't computed, as no `finish_parse()`
+ * variant uses it.
+ */
+template <class Duration>
+inline
+detail::iso_status
+parse_program::run_iso(const char* x,
+                       date::fields<Duration>& fds,
+                       std::string* abbrev,
+                       std::chrono::minutes* offset) const {
+  using detail::iso_status;
+  using detail::iso_read_field;
+  using detail::parse_op;
+  using std::chrono::hours;
+  using std::chrono::minutes;
+
+  using dfs = date::detail::decimal_format_seconds<Duration>;
+  CONSTDATA unsigned fraction_width = Duration::period::den == 1 ? 0 : dfs::width;
+
+  int Y = detail::not_a_year;
+  int m = detail::not_a_month;
+  int d = detail::not_a_day;
+  int H = detail::not_a_hour;
+  int M = detail::not_a_minute;
+  Duration s = Duration::min();
+  minutes toff = detail::not_a_offset;
+  const char* abbrev_begin = x;
+  const char* abbrev_end = x;
+
+  const char* p = x;
+
+  // Set when a field stops at the end of `x`, after which only white space
+  // can match, like with `parse_reader`
+  bool eof = false;
+
+  for (const detail::parse_instruction& instruction : instructions_) {
+    if (eof && instruction.op != parse_op::whitespace) {
+      return iso_status::failed;
+    }
+
+    iso_status status = iso_status::parsed;
+
+    switch (instruction.op) {
+    case parse_op::literal: {
+      if (*p != instruction.c) {
+        return iso_status::failed;
+      }
+      ++p;
+      break;
+    }
+    case parse_op::whitespace: {
+      if (eof) {
+        break;
+      }
+      while (detail::parse_is_space(*p)) {
+        ++p;
+      }
+      eof = *p == '\0';
+      break;
+    }
+    case parse_op::year: {
+      // A sign counts towards the width of `%Y`
+      if (*p == '-' || *p == '+') {
+        return iso_status::fallback;
+      }
+      status = iso_read_field(p, 4, Y);
+      break;
+    }
+    case parse_op::month: status = iso_read_field(p, 2, m); break;
+    case parse_op::day: status = iso_read_field(p, 2, d); break;
+    case parse_op::hour: status = iso_read_field(p, 2, H); break;
+    case parse_op::minute: status = iso_read_field(p, 2, M); break;
+    case parse_op::second: {
+      // `read_seconds()` also reads a leading decimal mark
+      if (*p == decimal_mark_) {
+        return iso_status::fallback;
+      }
+
+      int S;
+      status = iso_read_field(p, 2, S);
+      if (status != iso_status::parsed) {
+        break;
+      }
+
+      typename Duration::rep subseconds = 0;
+
+      if (fraction_width != 0) {
+        if (*p == decimal_mark_) {
+          ++p;
+
+          unsigned n = 0;
+          while (n < fraction_width && detail::parse_is_digit(*p)) {
+            subseconds = 10 * subseconds + (*p - '0');
+            ++p;
+            ++n;
+          }
+
+          eof = n < fraction_width && *p == '\0';
+
+          for (; n < fraction_width; ++n) {
+            subseconds *= 10;
+          }
+        } else if (detail::parse_is_digit(*p)) {
+          return iso_status::fallback;
+        } else {
+          eof = *p == '\0';
+        }
+      }
+
+      s = std::chrono::seconds{S} + Duration{subseconds};
+      break;
+    }
+    case parse_op::offset:
+    case parse_op::offset_colon: {
+      // Only `[+-]hhmm` for `%z` and `[+-]hh:mm` for `%Ez`
+      const bool neg = *p == '-';
+      if (*p == '-' || *p == '+') {
+        ++p;
+      }
+
+      int tH;
+      int tM;
+
+      if (iso_read_field(p, 2, tH) != iso_status::parsed) {
+        return iso_status::fallback;
+      }
+      if (instruction.op == parse_op::offset_colon) {
+        if (*p != ':') {
+          return iso_status::fallback;
+        }
+        ++p;
+      }
+      if (iso_read_field(p, 2, tM) != iso_status::parsed) {
+        return iso_status::fallback;
+      }
+
+      toff = hours{tH} + minutes{tM};
+      if (neg) {
+        toff = -toff;
+      }
+      break;
+    }
+    case parse_op::abbrev: {
+      abbrev_begin = p;
+      while (detail::parse_is_abbrev_char(*p)) {
+        ++p;
+      }
+      abbrev_end = p;
+
+      if (abbrev_begin == abbrev_end) {
+        return iso_status::failed;
+      }
+
+      eof = *p == '\0';
+      break;
+    }
+    default: {
+      return iso_status::fallback;
+    }
+    }
+
+    if (status != iso_status::parsed) {
+      return status;
+    }
+  }
+
+  fds.ymd = date::year{Y}/m/d;
+
+  if (H != detail::not_a_hour) {
+    fds.has_tod = true;
+    fds.tod = date::hh_mm_ss<Duration>{hours{H}};
+  }
+  if (M != detail::not_a_minute) {
+    fds.has_tod = true;
+    fds.tod.minutes(date::detail::undocumented{}) = minutes{M};
+  }
+  if (s != Duration::min()) {
+    fds.has_tod = true;
+    const dfs decomposed{s};
+    fds.tod.seconds(date::detail::undocumented{}) = decomposed.seconds();
+    fds.tod.subseconds(date::detail::undocumented{}) = decomposed.subseconds();
+  }
+  if (abbrev != nullptr) {
+    abbrev->assign(abbrev_begin, abbrev_end);
+  }
+  if (offset != nullptr && toff != detail::not_a_offset) {
+    *offset = toff;
+  }
+
+  return iso_status::parsed;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * The counterparts to the typed `from_stream()` variants
+ */
+
+template <class Duration>
+inline
+bool
+parse_program::run(const char* x,
+                   date::sys_time<Duration>& tp,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
+  std::chrono::minutes offset_local{};
+  std::chrono::minutes* offptr = offset ? offset : &offset_local;
+  date::fields<CT> fds{};
+  fds.has_tod = true;
+  return run(x, fds, abbrev, offptr) && detail::finish_parse(fds, *offptr, tp);
+}
+
+template <class Duration>
+inline
+bool
+parse_program::run(const char* x,
+                   date::local_time<Duration>& tp,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
+  date::fields<CT> fds{};
+  fds.has_tod = true;
+  return run(x, fds, abbrev, offset) && detail::finish_parse(fds, tp);
+}
+
+inline
+bool
+parse_program::run(const char* x,
+                   date::year& y,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  date::fields<std::chrono::seconds> fds{};
+  return run(x, fds, abbrev, offset) && detail::finish_parse(fds, y);
+}
+
+inline
+bool
+parse_program::run(const char* x,
+                   date::year_month& ym,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  date::fields<std::chrono::seconds> fds{};
+  return run(x, fds, abbrev, offset) && detail::finish_parse(fds, ym);
+}
+
+template <class Duration>
+inline
+bool
+parse_program::run(const char* x,
+                   date::year_month_day& ymd,
+                   date::hh_mm_ss<Duration>& tod,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
+  std::chrono::minutes offset_local{};
+  std::chrono::minutes* offptr = offset ? offset : &offset_local;
+  date::fields<CT> fds{};
+  fds.has_tod = true;
+  return run(x, fds, abbrev, offptr) && detail::finish_parse(fds, ymd, tod);
+}
+
+inline
+bool
+parse_program::run(const char* x,
+                   date::year_month_day& ymd,
+                   std::string* abbrev,
+                   std::chrono::minutes* offset) const {
+  date::fields<std::chrono::seconds> fds{};
+  return run(x, fds, abbrev, offset) && detail::finish_parse(fds, ymd);
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * The programs for each of `fmts`, compiled once per call, and the order to
+ * try them in
+ *
+ * Formats are tried in the order they are provided, and the first one that
+ * parses an element wins. Inputs that mix formats, but are dominated by one
+ * of them, would pay for a failed attempt with every earlier format for most
+ * elements. So when a format that excludes every format before it, meaning
+ * that no string can be parsed by both, parses an element, it is moved to the
+ * front. Trying it first can't change which format wins. Every other format
+ * is still tried in the order it was provided. Formats that overlap with an
+ * earlier one, like `"%Y-%m-%d %H"` after `"%Y-%m-%d"`, are never moved.
+ *
+ * `hit()` and `repeat()` also count the elements parsed by each format, which
+ * `signal_hits()` reports back to R.
+ *
+ * `fmts` and the names must outlive the programs.
+ */
+class parse_programs
+{
+  std::vector<parse_program> programs_;
+  std::vector<bool> promotable_;
+  std::vector<r_ssize> order_;
+  std::vector<double> hits_;
+
+public:
+  parse_programs(const std::vector<std::string>& fmts,
+                 const std::pair<const std::string*, const std::string*>& month_names_pair,
+                 const std::pair<const std::string*, const std::string*>& weekday_names_pair,
+                 const std::pair<const std::string*, const std::string*>& ampm_names_pair,
+                 const char& decimal_mark);
+
+  r_ssize size() const noexcept;
+  const parse_program& operator[](r_ssize k) const noexcept;
+
+  r_ssize hit(r_ssize k);
+  void repeat(r_ssize j);
+  void signal_hits() const;
+};
+
+inline
+parse_programs::parse_programs(const std::vector<std::string>& fmts,
+                               const std::pair<const std::string*, const std::string*>& month_names_pair,
+                               const std::pair<const std::string*, const std::string*>& weekday_names_pair,
+                               const std::pair<const std::string*, const std::string*>& ampm_names_pair,
+                               const char& decimal_mark) {
+  const r_ssize size = static_cast<r_ssize>(fmts.size());
+
+  programs_.reserve(size);
+  for (const std::string& fmt : fmts) {
+    programs_.emplace_back(fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark);
+  }
+
+  promotable_.assign(size, false);
+  for (r_ssize j = 1; j < size; ++j) {
+    bool promotable = true;
+    for (r_ssize i = 0; i < j && promotable; ++i) {
+      promotable = programs_[j].excludes(programs_[i]);
+    }
+    promotable_[j] = promotable;
+  }
+
+  order_.resize(size);
+  for (r_ssize i = 0; i < size; ++i) {
+    order_[i] = i;
+  }
+
+  hits_.assign(size, 0);
+}
+
+inline
+r_ssize
+parse_programs::size() const noexcept {
+  return static_cast<r_ssize>(programs_.size());
+}
+
+// The `k`-th program to try
+inline
+const parse_program&
+parse_programs::operator[](r_ssize k) const noexcept {
+  return programs_[order_[k]];
+}
+
+/*
+ * Record that the `k`-th program to try parsed an element, and return the
+ * index of its format
+ */
+inline
+r_ssize
+parse_programs::hit(r_ssize k) {
+  const r_ssize j = order_[k];
+
+  ++hits_[j];
+
+  if (k == 0 || !promotable_[j]) {
+    return j;
+  }
+
+  // `j` first, then the rest in the order they were provided
+  order_[0] = j;
+  r_ssize loc = 1;
+  for (r_ssize i = 0; i < size(); ++i) {
+    if (i != j) {
+      order_[loc] = i;
+      ++loc;
+    }
+  }
+
+  return j;
+}
+
+/*
+ * Record that the format at `j` parsed an element that was already parsed
+ * once, like a repeated string, without trying any programs
+ */
+inline
+void
+parse_programs::repeat(r_ssize j) {
+  ++hits_[j];
+}
+
+/*
+ * Signals a `clock_parse_format_hits` condition holding the number of
+ * elements parsed by each format. Only signalled when there is more than one
+ * format, as the count is otherwise just the number of successes, and when
+ * the `clock.parse_format_hits` option is `TRUE`, so parsing doesn't call back
+ * into R when nobody is listening.
+ */
+inline
+void
+parse_programs::signal_hits() const {
+  if (programs_.size() < 2) {
+    return;
+  }
+  if (Rf_asLogical(Rf_GetOption1(syms_clock_parse_format_hits)) != TRUE) {
+    return;
+  }
+  const r_ssize size = this->size();
+  cpp11::writable::doubles hits(size);
+  for (r_ssize i = 0; i < size; ++i) {
+    hits[i] = hits_[i];
+  }
+  auto r_signal = cpp11::package("clock")["signal_clock_parse_format_hits"];
+  r_signal(hits);
+}
+
+} // namespace rclock
+
+#endif
@@ -81,6 +81,405 @@ read(std::basic_istream<CharT, Traits>& is,
 
 namespace rclock {
 
+namespace detail {
+
+// Sentinels for fields that a format didn't parse
+CONSTDATA int not_a_year = std::numeric_limits<short>::min();
+CONSTDATA int not_a_2digit_year = 100;
+CONSTDATA int not_a_century = std::numeric_limits<int>::min();
+CONSTDATA int not_a_month = 0;
+CONSTDATA int not_a_day = 0;
+CONSTDATA int not_a_hour = std::numeric_limits<int>::min();
+CONSTDATA int not_a_hour_12_value = 0;
+CONSTDATA int not_a_minute = not_a_hour;
+CONSTDATA int not_a_doy = -1;
+CONSTDATA int not_a_weekday = 8;
+CONSTDATA int not_a_week_num = 100;
+CONSTDATA int not_a_ampm = -1;
+CONSTDATA std::chrono::minutes not_a_offset = std::chrono::minutes::min();
+
+/*
+ * Fields as they are read from a string, before they are resolved against
+ * each other. Filled by `from_stream()` and by `parse_program`, which then
+ * share `resolve_fields()` and `finish_parse()`.
+ */
+template <class Duration, class String>
+struct parse_fields
+{
+    int Y = not_a_year;             // c, F, Y                   *
+    int y = not_a_2digit_year;      // D, x, y                   *
+    int g = not_a_2digit_year;      // g                         *
+    int G = not_a_year;             // G                         *
+    int C = not_a_century;          // C                         *
+    int m = not_a_month;            // b, B, h, m, c, D, F, x    *
+    int d = not_a_day;              // c, d, D, e, F, x          *
+    int j = not_a_doy;              // j                         *
+    int wd = not_a_weekday;         // a, A, u, w                *
+    int H = not_a_hour;             // c, H, R, T, X             *
+    int I = not_a_hour_12_value;    // I, r                      *
+    int p = not_a_ampm;             // p, r                      *
+    int M = not_a_minute;           // c, M, r, R, T, X          *
+    Duration s = Duration::min();   // c, r, S, T, X             *
+    int U = not_a_week_num;         // U                         *
+    int V = not_a_week_num;         // V                         *
+    int W = not_a_week_num;         // W                         *
+    String abbrev;                  // Z                         *
+    std::chrono::minutes offset = not_a_offset;  // z            *
+};
+
+/*
+ * Resolve the parsed fields against each other, i.e. two digit years against
+ * centuries, ISO and week based fields, day of year, weekdays, and 12-hour
+ * clocks, and write them into `fds`. Returns `false` if they are inconsistent.
+ */
+template <class Duration, class String>
+bool
+resolve_fields(parse_fields<Duration, String>& parsed,
+               date::fields<Duration>& fds,
+               String* abbrev,
+               std::chrono::minutes* offset)
+{
+    using namespace date;
+    using std::chrono::duration_cast;
+    using std::chrono::hours;
+    using std::chrono::minutes;
+
+    int& Y = parsed.Y;
+    int& y = parsed.y;
+    int& g = parsed.g;
+    int& G = parsed.G;
+    int& C = parsed.C;
+    int& m = parsed.m;
+    int& d = parsed.d;
+    int& j = parsed.j;
+    int& wd = parsed.wd;
+    int& H = parsed.H;
+    int& I = parsed.I;
+    int& p = parsed.p;
+    int& M = parsed.M;
+    const Duration& s = parsed.s;
+    const int& U = parsed.U;
+    const int& V = parsed.V;
+    const int& W = parsed.W;
+
+    if (y != not_a_2digit_year)
+    {
+        // Convert y and an optional C to Y
+        if (!(0 <= y && y <= 99))
+            return false;
+        if (C == not_a_century)
+        {
+            if (Y == not_a_year)
+            {
+                if (y >= 69)
+                    C = 19;
+                else
+                    C = 20;
+            }
+            else
+            {
+                C = (Y >= 0 ? Y : Y-100) / 100;
+            }
+        }
+        int tY;
+        if (C >= 0)
+            tY = 100*C + y;
+        else
+            tY = 100*(C+1) - (y == 0 ? 100 : y);
+        if (Y != not_a_year && Y != tY)
+            return false;
+        Y = tY;
+    }
+    if (g != not_a_2digit_year)
+    {
+        // Convert g and an optional C to G
+        if (!(0 <= g && g <= 99))
+            return false;
+        if (C == not_a_century)
+        {
+            if (G == not_a_year)
+            {
+                if (g >= 69)
+                    C = 19;
+                else
+                    C = 20;
+            }
+            else
+            {
+                C = (G >= 0 ? G : G-100) / 100;
+            }
+        }
+        int tG;
+        if (C >= 0)
+            tG = 100*C + g;
+        else
+            tG = 100*(C+1) - (g == 0 ? 100 : g);
+        if (G != not_a_year && G != tG)
+            return false;
+        G = tG;
+    }
+    if (Y < static_cast<int>(year::min()) || Y > static_cast<int>(year::max()))
+        Y = not_a_year;
+    bool computed = false;
+    if (G != not_a_year && V != not_a_week_num && wd != not_a_weekday)
+    {
+        year_month_day ymd_trial = sys_days(year{G-1}/December/Thursday[last]) +
+                                   (Monday-Thursday) + weeks{V-1} +
+                                   (date::weekday{static_cast<unsigned>(wd)}-Monday);
+        if (Y == not_a_year)
+            Y = static_cast<int>(ymd_trial.year());
+        else if (year{Y} != ymd_trial.year())
+            return false;
+        if (m == not_a_month)
+            m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
+        else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
+            return false;
+        if (d == not_a_day)
+            d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
+        else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
+            return false;
+        computed = true;
+    }
+    if (Y != not_a_year && U != not_a_week_num && wd != not_a_weekday)
+    {
+        year_month_day ymd_trial = sys_days(year{Y}/January/Sunday[1]) +
+                                   weeks{U-1} +
+                                   (date::weekday{static_cast<unsigned>(wd)} - Sunday);
+        if (year{Y} != ymd_trial.year())
+            return false;
+        if (m == not_a_month)
+            m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
+        else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
+            return false;
+        if (d == not_a_day)
+            d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
+        else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
+            return false;
+        computed = true;
+    }
+    if (Y != not_a_year && W != not_a_week_num && wd != not_a_weekday)
+    {
+        year_month_day ymd_trial = sys_days(year{Y}/January/Monday[1]) +
+                                   weeks{W-1} +
+                                   (date::weekday{static_cast<unsigned>(wd)} - Monday);
+        if (year{Y} != ymd_trial.year())
+            return false;
+        if (m == not_a_month)
+            m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
+        else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
+            return false;
+        if (d == not_a_day)
+            d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
+        else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
+            return false;
+        computed = true;
+    }
+    if (j != not_a_doy && Y != not_a_year)
+    {
+        auto ymd_trial = year_month_day{local_days(year{Y}/1/1) + days{j-1}};
+        if (m == 0)
+            m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
+        else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
+            return false;
+        if (d == 0)
+            d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
+        else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
+            return false;
+        j = not_a_doy;
+    }
+    auto ymd = year{Y}/m/d;
+    if (ymd.ok())
+    {
+        if (wd == not_a_weekday)
+            wd = static_cast<int>((date::weekday(sys_days(ymd)) - Sunday).count());
+        else if (wd != static_cast<int>((date::weekday(sys_days(ymd)) - Sunday).count()))
+            return false;
+        if (!computed)
+        {
+            if (G != not_a_year || V != not_a_week_num)
+            {
+                sys_days sd = ymd;
+                auto G_trial = year_month_day{sd + days{3}}.year();
+                auto start = sys_days((G_trial - years{1})/December/Thursday[last]) +
+                             (Monday - Thursday);
+                if (sd < start)
+                {
+                    --G_trial;
+                    if (V != not_a_week_num)
+                        start = sys_days((G_trial - years{1})/December/Thursday[last])
+                                + (Monday - Thursday);
+                }
+                if (G != not_a_year && G != static_cast<int>(G_trial))
+                    return false;
+                if (V != not_a_week_num)
+                {
+                    auto V_trial = duration_cast<weeks>(sd - start).count() + 1;
+                    if (V != V_trial)
+                        return false;
+                }
+            }
+            if (U != not_a_week_num)
+            {
+                auto start = sys_days(Sunday[1]/January/ymd.year());
+                auto U_trial = floor<weeks>(sys_days(ymd) - start).count() + 1;
+                if (U != U_trial)
+                    return false;
+            }
+            if (W != not_a_week_num)
+            {
+                auto start = sys_days(Monday[1]/January/ymd.year());
+                auto W_trial = floor<weeks>(sys_days(ymd) - start).count() + 1;
+                if (W != W_trial)
+                    return false;
+            }
+        }
+    }
+    fds.ymd = ymd;
+    if (I != not_a_hour_12_value)
+    {
+        if (!(1 <= I && I <= 12))
+            return false;
+        if (p != not_a_ampm)
+        {
+            // p is in [0, 1] == [AM, PM]
+            // Store trial H in I
+            if (I == 12)
+                --p;
+            I += p*12;
+            // Either set H from I or make sure H and I are consistent
+            if (H == not_a_hour)
+                H = I;
+            else if (I != H)
+                return false;
+        }
+        else  // p == not_a_ampm
+        {
+            // if H, make sure H and I could be consistent
+            if (H != not_a_hour)
+            {
+                if (I == 12)
+                {
+                    if (H != 0 && H != 12)
+                        return false;
+                }
+                else if (!(I == H || I == H+12))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+    if (H != not_a_hour)
+    {
+        fds.has_tod = true;
+        fds.tod = hh_mm_ss<Duration>{hours{H}};
+    }
+    if (M != not_a_minute)
+    {
+        fds.has_tod = true;
+        fds.tod.minutes(date::detail::undocumented{}) = minutes{M};
+    }
+    if (s != Duration::min())
+    {
+        fds.has_tod = true;
+        const date::detail::decimal_format_seconds<Duration> dfs{s};
+        fds.tod.seconds(date::detail::undocumented{}) = dfs.seconds();
+        fds.tod.subseconds(date::detail::undocumented{}) = dfs.subseconds();
+    }
+    if (j != not_a_doy)
+    {
+        fds.has_tod = true;
+        fds.tod.hours(date::detail::undocumented{}) += hours{days{j}};
+    }
+    if (wd != not_a_weekday)
+        fds.wd = date::weekday{static_cast<unsigned>(wd)};
+    if (abbrev != nullptr)
+        *abbrev = std::move(parsed.abbrev);
+    if (offset != nullptr && parsed.offset != not_a_offset)
+      *offset = parsed.offset;
+    return true;
+}
+
+/*
+ * Turn resolved fields into the requested type. Return `false` if the fields
+ * don't form a valid value of that type.
+ */
+
+template <class Duration, class CT>
+inline
+bool
+finish_parse(const date::fields<CT>& fds,
+             const std::chrono::minutes& offset,
+             date::sys_time<Duration>& tp)
+{
+    if (!fds.ymd.ok() || !fds.tod.in_conventional_range())
+        return false;
+    tp = date::detail::round_i<Duration>(date::sys_days(fds.ymd) - offset + fds.tod.to_duration());
+    return true;
+}
+
+template <class Duration, class CT>
+inline
+bool
+finish_parse(const date::fields<CT>& fds,
+             date::local_time<Duration>& tp)
+{
+    if (!fds.ymd.ok() || !fds.tod.in_conventional_range())
+        return false;
+    tp = date::detail::round_i<Duration>(date::local_days(fds.ymd) + fds.tod.to_duration());
+    return true;
+}
+
+inline
+bool
+finish_parse(const date::fields<std::chrono::seconds>& fds,
+             date::year& y)
+{
+    if (!fds.ymd.year().ok())
+        return false;
+    y = fds.ymd.year();
+    return true;
+}
+
+inline
+bool
+finish_parse(const date::fields<std::chrono::seconds>& fds,
+             date::year_month& ym)
+{
+    if (!fds.ymd.month().ok())
+        return false;
+    ym = fds.ymd.year()/fds.ymd.month();
+    return true;
+}
+
+// Fields must be `ok()` independently, not jointly. i.e. invalid dates are allowed.
+template <class Duration, class CT>
+inline
+bool
+finish_parse(const date::fields<CT>& fds,
+             date::year_month_day& ymd,
+             date::hh_mm_ss<Duration>& tod)
+{
+    if (!fds.ymd.year().ok() || !fds.ymd.month().ok() || !fds.ymd.day().ok() || !fds.tod.in_conventional_range())
+        return false;
+    ymd = fds.ymd;
+    tod = fds.tod;
+    return true;
+}
+
+inline
+bool
+finish_parse(const date::fields<std::chrono::seconds>& fds,
+             date::year_month_day& ymd)
+{
+    if (!fds.ymd.year().ok() || !fds.ymd.month().ok() || !fds.ymd.day().ok())
+        return false;
+    ymd = fds.ymd;
+    return true;
+}
+
+} // namespace detail
+
 template <class CharT, class Traits, class Duration, class Alloc = std::allocator<CharT>>
 std::basic_istream<CharT, Traits>&
 from_stream(std::basic_istream<CharT, Traits>& is,
@@ -113,40 +512,42 @@ from_stream(std::basic_istream<CharT, Traits>& is,
         auto modified = CharT{};
         auto width = -1;
 
-        CONSTDATA int not_a_year = numeric_limits<short>::min();
-        CONSTDATA int not_a_2digit_year = 100;
-        CONSTDATA int not_a_century = numeric_limits<int>::min();
-        CONSTDATA int not_a_month = 0;
-        CONSTDATA int not_a_day = 0;
-        CONSTDATA int not_a_hour = numeric_limits<int>::min();
-        CONSTDATA int not_a_hour_12_value = 0;
-        CONSTDATA int not_a_minute = not_a_hour;
+        rclock::detail::parse_fields<Duration, std::basic_string<CharT, Traits, Alloc>> parsed{};
+
+        using rclock::detail::not_a_year;
+        using rclock::detail::not_a_2digit_year;
+        using rclock::detail::not_a_century;
+        using rclock::detail::not_a_month;
+        using rclock::detail::not_a_day;
+        using rclock::detail::not_a_hour;
+        using rclock::detail::not_a_hour_12_value;
+        using rclock::detail::not_a_minute;
+        using rclock::detail::not_a_doy;
+        using rclock::detail::not_a_weekday;
+        using rclock::detail::not_a_week_num;
+        using rclock::detail::not_a_ampm;
+        using rclock::detail::not_a_offset;
         CONSTDATA Duration not_a_second = Duration::min();
-        CONSTDATA int not_a_doy = -1;
-        CONSTDATA int not_a_weekday = 8;
-        CONSTDATA int not_a_week_num = 100;
-        CONSTDATA int not_a_ampm = -1;
-        CONSTDATA minutes not_a_offset = minutes::min();
 
-        int Y = not_a_year;             // c, F, Y                   *
-        int y = not_a_2digit_year;      // D, x, y                   *
-        int g = not_a_2digit_year;      // g                         *
-        int G = not_a_year;             // G                         *
-        int C = not_a_century;          // C                         *
-        int m = not_a_month;            // b, B, h, m, c, D, F, x    *
-        int d = not_a_day;              // c, d, D, e, F, x          *
-        int j = not_a_doy;              // j                         *
-        int wd = not_a_weekday;         // a, A, u, w                *
-        int H = not_a_hour;             // c, H, R, T, X             *
-        int I = not_a_hour_12_value;    // I, r                      *
-        int p = not_a_ampm;             // p, r                      *
-        int M = not_a_minute;           // c, M, r, R, T, X          *
-        Duration s = not_a_second;      // c, r, S, T, X             *
-        int U = not_a_week_num;         // U                         *
-        int V = not_a_week_num;         // V                         *
-        int W = not_a_week_num;         // W                         *
-        std::basic_string<CharT, Traits, Alloc> temp_abbrev;  // Z   *
-        minutes temp_offset = not_a_offset;  // z                    *
+        int& Y = parsed.Y;              // c, F, Y                   *
+        int& y = parsed.y;              // D, x, y                   *
+        int& g = parsed.g;              // g                         *
+        int& G = parsed.G;              // G                         *
+        int& C = parsed.C;              // C                         *
+        int& m = parsed.m;              // b, B, h, m, c, D, F, x    *
+        int& d = parsed.d;              // c, d, D, e, F, x          *
+        int& j = parsed.j;              // j                         *
+        int& wd = parsed.wd;            // a, A, u, w                *
+        int& H = parsed.H;              // c, H, R, T, X             *
+        int& I = parsed.I;              // I, r                      *
+        int& p = parsed.p;              // p, r                      *
+        int& M = parsed.M;              // c, M, r, R, T, X          *
+        Duration& s = parsed.s;         // c, r, S, T, X             *
+        int& U = parsed.U;              // U                         *
+        int& V = parsed.V;              // V                         *
+        int& W = parsed.W;              // W                         *
+        std::basic_string<CharT, Traits, Alloc>& temp_abbrev = parsed.abbrev;  // Z
+        minutes& temp_offset = parsed.offset;  // z
 
         using date::detail::read;
         using date::detail::rs;
@@ -961,247 +1362,10 @@ from_stream(std::basic_istream<CharT, Traits>& is,
             else
                 read(is, CharT{'%'}, width, modified);
         }
-        if (!is.fail())
-        {
-            if (y != not_a_2digit_year)
-            {
-                // Convert y and an optional C to Y
-                if (!(0 <= y && y <= 99))
-                    goto broken;
-                if (C == not_a_century)
-                {
-                    if (Y == not_a_year)
-                    {
-                        if (y >= 69)
-                            C = 19;
-                        else
-                            C = 20;
-                    }
-                    else
-                    {
-                        C = (Y >= 0 ? Y : Y-100) / 100;
-                    }
-                }
-                int tY;
-                if (C >= 0)
-                    tY = 100*C + y;
-                else
-                    tY = 100*(C+1) - (y == 0 ? 100 : y);
-                if (Y != not_a_year && Y != tY)
-                    goto broken;
-                Y = tY;
-            }
-            if (g != not_a_2digit_year)
-            {
-                // Convert g and an optional C to G
-                if (!(0 <= g && g <= 99))
-                    goto broken;
-                if (C == not_a_century)
-                {
-                    if (G == not_a_year)
-                    {
-                        if (g >= 69)
-                            C = 19;
-                        else
-                            C = 20;
-                    }
-                    else
-                    {
-                        C = (G >= 0 ? G : G-100) / 100;
-                    }
-                }
-                int tG;
-                if (C >= 0)
-                    tG = 100*C + g;
-                else
-                    tG = 100*(C+1) - (g == 0 ? 100 : g);
-                if (G != not_a_year && G != tG)
-                    goto broken;
-                G = tG;
-            }
-            if (Y < static_cast<int>(year::min()) || Y > static_cast<int>(year::max()))
-                Y = not_a_year;
-            bool computed = false;
-            if (G != not_a_year && V != not_a_week_num && wd != not_a_weekday)
-            {
-                year_month_day ymd_trial = sys_days(year{G-1}/December/Thursday[last]) +
-                                           (Monday-Thursday) + weeks{V-1} +
-                                           (date::weekday{static_cast<unsigned>(wd)}-Monday);
-                if (Y == not_a_year)
-                    Y = static_cast<int>(ymd_trial.year());
-                else if (year{Y} != ymd_trial.year())
-                    goto broken;
-                if (m == not_a_month)
-                    m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
-                else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
-                    goto broken;
-                if (d == not_a_day)
-                    d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
-                else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
-                    goto broken;
-                computed = true;
-            }
-            if (Y != not_a_year && U != not_a_week_num && wd != not_a_weekday)
-            {
-                year_month_day ymd_trial = sys_days(year{Y}/January/Sunday[1]) +
-                                           weeks{U-1} +
-                                           (date::weekday{static_cast<unsigned>(wd)} - Sunday);
-                if (year{Y} != ymd_trial.year())
-                    goto broken;
-                if (m == not_a_month)
-                    m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
-                else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
-                    goto broken;
-                if (d == not_a_day)
-                    d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
-                else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
-                    goto broken;
-                computed = true;
-            }
-            if (Y != not_a_year && W != not_a_week_num && wd != not_a_weekday)
-            {
-                year_month_day ymd_trial = sys_days(year{Y}/January/Monday[1]) +
-                                           weeks{W-1} +
-                                           (date::weekday{static_cast<unsigned>(wd)} - Monday);
-                if (year{Y} != ymd_trial.year())
-                    goto broken;
-                if (m == not_a_month)
-                    m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
-                else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
-                    goto broken;
-                if (d == not_a_day)
-                    d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
-                else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
-                    goto broken;
-                computed = true;
-            }
-            if (j != not_a_doy && Y != not_a_year)
-            {
-                auto ymd_trial = year_month_day{local_days(year{Y}/1/1) + days{j-1}};
-                if (m == 0)
-                    m = static_cast<int>(static_cast<unsigned>(ymd_trial.month()));
-                else if (month(static_cast<unsigned>(m)) != ymd_trial.month())
-                    goto broken;
-                if (d == 0)
-                    d = static_cast<int>(static_cast<unsigned>(ymd_trial.day()));
-                else if (day(static_cast<unsigned>(d)) != ymd_trial.day())
-                    goto broken;
-                j = not_a_doy;
-            }
-            auto ymd = year{Y}/m/d;
-            if (ymd.ok())
-            {
-                if (wd == not_a_weekday)
-                    wd = static_cast<int>((date::weekday(sys_days(ymd)) - Sunday).count());
-                else if (wd != static_cast<int>((date::weekday(sys_days(ymd)) - Sunday).count()))
-                    goto broken;
-                if (!computed)
-                {
-                    if (G != not_a_year || V != not_a_week_num)
-                    {
-                        sys_days sd = ymd;
-                        auto G_trial = year_month_day{sd + days{3}}.year();
-                        auto start = sys_days((G_trial - years{1})/December/Thursday[last]) +
-                                     (Monday - Thursday);
-                        if (sd < start)
-                        {
-                            --G_trial;
-                            if (V != not_a_week_num)
-                                start = sys_days((G_trial - years{1})/December/Thursday[last])
-                                        + (Monday - Thursday);
-                        }
-                        if (G != not_a_year && G != static_cast<int>(G_trial))
-                            goto broken;
-                        if (V != not_a_week_num)
-                        {
-                            auto V_trial = duration_cast<weeks>(sd - start).count() + 1;
-                            if (V != V_trial)
-                                goto broken;
-                        }
-                    }
-                    if (U != not_a_week_num)
-                    {
-                        auto start = sys_days(Sunday[1]/January/ymd.year());
-                        auto U_trial = floor<weeks>(sys_days(ymd) - start).count() + 1;
-                        if (U != U_trial)
-                            goto broken;
-                    }
-                    if (W != not_a_week_num)
-                    {
-                        auto start = sys_days(Monday[1]/January/ymd.year());
-                        auto W_trial = floor<weeks>(sys_days(ymd) - start).count() + 1;
-                        if (W != W_trial)
-                            goto broken;
-                    }
-                }
-            }
-            fds.ymd = ymd;
-            if (I != not_a_hour_12_value)
-            {
-                if (!(1 <= I && I <= 12))
-                    goto broken;
-                if (p != not_a_ampm)
-                {
-                    // p is in [0, 1] == [AM, PM]
-                    // Store trial H in I
-                    if (I == 12)
-                        --p;
-                    I += p*12;
-                    // Either set H from I or make sure H and I are consistent
-                    if (H == not_a_hour)
-                        H = I;
-                    else if (I != H)
-                        goto broken;
-                }
-                else  // p == not_a_ampm
-                {
-                    // if H, make sure H and I could be consistent
-                    if (H != not_a_hour)
-                    {
-                        if (I == 12)
-                        {
-                            if (H != 0 && H != 12)
-                                goto broken;
-                        }
-                        else if (!(I == H || I == H+12))
-                        {
-                            goto broken;
-                        }
-                    }
-                }
-            }
-            if (H != not_a_hour)
-            {
-                fds.has_tod = true;
-                fds.tod = hh_mm_ss<Duration>{hours{H}};
-            }
-            if (M != not_a_minute)
-            {
-                fds.has_tod = true;
-                fds.tod.minutes(date::detail::undocumented{}) = minutes{M};
-            }
-            if (s != not_a_second)
-            {
-                fds.has_tod = true;
-                const date::detail::decimal_format_seconds<Duration> dfs{s};
-                fds.tod.seconds(date::detail::undocumented{}) = dfs.seconds();
-                fds.tod.subseconds(date::detail::undocumented{}) = dfs.subseconds();
-            }
-            if (j != not_a_doy)
-            {
-                fds.has_tod = true;
-                fds.tod.hours(date::detail::undocumented{}) += hours{days{j}};
-            }
-            if (wd != not_a_weekday)
-                fds.wd = date::weekday{static_cast<unsigned>(wd)};
-            if (abbrev != nullptr)
-                *abbrev = std::move(temp_abbrev);
-            if (offset != nullptr && temp_offset != not_a_offset)
-              *offset = temp_offset;
-        }
-       return is;
+        if (!is.fail() && !rclock::detail::resolve_fields(parsed, fds, abbrev, offset))
+            is.setstate(ios::failbit);
+        return is;
     }
-broken:
     is.setstate(ios::failbit);
     return is;
 }
@@ -1220,16 +1384,13 @@ from_stream(std::basic_istream<CharT, Traits>& is,
             std::chrono::minutes* offset = nullptr)
 {
   using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
-  using date::detail::round_i;
   std::chrono::minutes offset_local{};
   auto offptr = offset ? offset : &offset_local;
   date::fields<CT> fds{};
   fds.has_tod = true;
   rclock::from_stream(is, fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark, fds, abbrev, offptr);
-  if (!fds.ymd.ok() || !fds.tod.in_conventional_range())
+  if (!is.fail() && !detail::finish_parse(fds, *offptr, tp))
     is.setstate(std::ios::failbit);
-  if (!is.fail())
-    tp = round_i<Duration>(date::sys_days(fds.ymd) - *offptr + fds.tod.to_duration());
   return is;
 }
 
@@ -1247,14 +1408,11 @@ from_stream(std::basic_istream<CharT, Traits>& is,
             std::chrono::minutes* offset = nullptr)
 {
   using CT = typename std::common_type<Duration, std::chrono::seconds>::type;
-  using date::detail::round_i;
   date::fields<CT> fds{};
   fds.has_tod = true;
   rclock::from_stream(is, fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark, fds, abbrev, offset);
-  if (!fds.ymd.ok() || !fds.tod.in_conventional_range())
+  if (!is.fail() && !detail::finish_parse(fds, tp))
     is.setstate(std::ios::failbit);
-  if (!is.fail())
-    tp = round_i<Duration>(date::local_days(fds.ymd) + fds.tod.to_duration());
   return is;
 }
 
@@ -1273,10 +1431,8 @@ from_stream(std::basic_istream<CharT, Traits>& is,
     using CT = std::chrono::seconds;
     date::fields<CT> fds{};
     rclock::from_stream(is, fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark, fds, abbrev, offset);
-    if (!fds.ymd.year().ok())
+    if (!is.fail() && !detail::finish_parse(fds, y))
         is.setstate(std::ios::failbit);
-    if (!is.fail())
-        y = fds.ymd.year();
     return is;
 }
 
@@ -1295,10 +1451,8 @@ from_stream(std::basic_istream<CharT, Traits>& is,
     using CT = std::chrono::seconds;
     date::fields<CT> fds{};
     rclock::from_stream(is, fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark, fds, abbrev, offset);
-    if (!fds.ymd.month().ok())
+    if (!is.fail() && !detail::finish_parse(fds, ym))
         is.setstate(std::ios::failbit);
-    if (!is.fail())
-        ym = fds.ymd.year()/fds.ymd.month();
     return is;
 }
 
@@ -1331,13 +1485,8 @@ from_stream(std::basic_istream<CharT, Traits>& is,
   date::fields<CT> fds{};
   fds.has_tod = true;
   rclock::from_stream(is, fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark, fds, abbrev, offptr);
-  // Fields must be `ok()` independently, not jointly. i.e. invalid dates are allowed.
-  if (!fds.ymd.year().ok() || !fds.ymd.month().ok() || !fds.ymd.day().ok() || !fds.tod.in_conventional_range())
+  if (!is.fail() && !detail::finish_parse(fds, ymd, tod))
     is.setstate(std::ios::failbit);
-  if (!is.fail()) {
-    ymd = fds.ymd;
-    tod = fds.tod;
-  }
   return is;
 }
 
@@ -1356,11 +1505,8 @@ from_stream(std::basic_istream<CharT, Traits>& is,
   using CT = std::chrono::seconds;
   date::fields<CT> fds{};
   rclock::from_stream(is, fmt, month_names_pair, weekday_names_pair, ampm_names_pair, decimal_mark, fds, abbrev, offset);
-  // Fields must be `ok()` independently, not jointly. i.e. invalid dates are allowed.
-  if (!fds.ymd.year().ok() || !fds.ymd.month().ok() || !fds.ymd.day().ok())
+  if (!is.fail() && !detail::finish_parse(fds, ymd))
     is.setstate(std::ios::failbit);
-  if (!is.fail())
-    ymd = fds.ymd;
   return is;
 }
 
@@ -1,6 +1,7 @@
 #include "rcrd.h"
 #include "utils.h"
 #include "enums.h"
+#include <algorithm>
 
 SEXP
 new_clock_rcrd_from_fields(SEXP fields, SEXP names, SEXP classes) {
@@ -83,6 +84,51 @@ clock_rcrd_proxy(SEXP x) {
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Packs the integer fields of a day-or-coarser calendar into a single integer
+ * key, `sum(field * multiplier)`, for comparing and ordering. `multipliers`
+ * must leave room for the full range of each finer field, so the key orders
+ * the same way as the fields do column by column. With years limited to
+ * `[-32767, 32767]`, multipliers up to 1024 always fit in an `int`.
+ */
+[[cpp11::register]]
+cpp11::writable::integers
+calendar_pack_cpp(cpp11::list_of<cpp11::integers> fields,
+                  const cpp11::integers& multipliers) {
+  const r_ssize n_fields = fields.size();
+
+  if (n_fields > multipliers.size()) {
+    clock_abort("Internal error: Must supply a multiplier for each field.");
+  }
+
+  const r_ssize size = fields[0].size();
+
+  cpp11::writable::integers out(size);
+  int* p_out = INTEGER(out);
+
+  std::fill(p_out, p_out + size, 0);
+
+  for (r_ssize j = 0; j < n_fields; ++j) {
+    const int* p_field = INTEGER_RO(fields[j]);
+    const int multiplier = multipliers[j];
+
+    for (r_ssize i = 0; i < size; ++i) {
+      if (p_out[i] == r_int_na) {
+        continue;
+      }
+      if (p_field[i] == r_int_na) {
+        p_out[i] = r_int_na;
+        continue;
+      }
+      p_out[i] += p_field[i] * multiplier;
+    }
+  }
+
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
 SEXP
 clock_rcrd_restore(SEXP x, SEXP to, SEXP classes) {
   const r_ssize n_fields = Rf_xlength(x);
@@ -1,6 +1,8 @@
 #include "duration.h"
 #include "get.h"
 #include "zone.h"
+#include "zone-cursor.h"
+#include "info.h"
 
 [[cpp11::register]]
 cpp11::writable::list
@@ -30,34 +32,28 @@ static
 inline
 cpp11::writable::list
 sys_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
-                   const cpp11::strings& zone) {
+                   const cpp11::strings& zone,
+                   const cpp11::logicals& columns) {
   using Duration = typename ClockDuration::chrono_duration;
 
   const ClockDuration x{fields};
   const r_ssize size = x.size();
 
-  rclock::duration::seconds begin(size);
-  rclock::duration::seconds end(size);
-  rclock::duration::seconds offset(size);
-  cpp11::writable::logicals dst(size);
-  cpp11::writable::strings abbreviation(size);
-
-  const std::chrono::minutes zero{0};
+  rclock::sys_info_columns out(size, columns);
 
   const bool recycle_zone = zone.size() == 1;
-  const date::time_zone* p_time_zone;
+  const date::time_zone* p_time_zone = NULL;
   if (recycle_zone) {
     const std::string zone_name = cpp11::r_string(zone[0]);
     p_time_zone = zone_name_load(zone_name);
   }
 
+  rclock::zone_cache cache;
+  rclock::zone_cursor cursor{p_time_zone};
+
   for (r_ssize i = 0; i < size; ++i) {
     if (x.is_na(i)) {
-      begin.assign_na(i);
-      end.assign_na(i);
-      offset.assign_na(i);
-      dst[i] = r_lgl_na;
-      SET_STRING_ELT(abbreviation, i, r_chr_na);
+      out.assign_na(i);
       continue;
     }
 
@@ -65,43 +61,34 @@ sys_time_info_impl(cpp11::list_of<cpp11::doubles>& fields,
     if (recycle_zone) {
       p_time_zone_elt = p_time_zone;
     } else {
-      const std::string zone_name_elt = cpp11::r_string(zone[i]);
-      p_time_zone_elt = zone_name_load(zone_name_elt);
+      p_time_zone_elt = cache.load(zone[i]);
     }
 
+    cursor.reset(p_time_zone_elt);
+
     const date::sys_time<Duration> elt{x[i]};
-    const date::sys_info info = rclock::get_info(elt, p_time_zone_elt);
+    const date::sys_info& info = cursor.get_info(elt);
 
-    begin.assign(info.begin.time_since_epoch(), i);
-    end.assign(info.end.time_since_epoch(), i);
-    offset.assign(info.offset, i);
-    dst[i] = info.save != zero;
-    SET_STRING_ELT(abbreviation, i, Rf_mkCharLenCE(info.abbrev.c_str(), info.abbrev.size(), CE_UTF8));
+    out.assign(info, i);
   }
 
-  cpp11::writable::list out_begin = begin.to_list();
-  cpp11::writable::list out_end = end.to_list();
-  cpp11::writable::list out_offset = offset.to_list();
-
-  cpp11::writable::list out = { out_begin, out_end, out_offset, dst, abbreviation};
-  out.names() = {"begin", "end", "offset", "dst", "abbreviation"};
-
-  return out;
+  return out.to_list();
 }
 
 [[cpp11::register]]
 cpp11::writable::list
 sys_time_info_cpp(cpp11::list_of<cpp11::doubles> fields,
                   const cpp11::integers& precision_int,
-                  const cpp11::strings& zone) {
+                  const cpp11::strings& zone,
+                  const cpp11::logicals& columns) {
   using namespace rclock;
 
   switch (parse_precision(precision_int)) {
-  case precision::day: return sys_time_info_impl<duration::days>(fields, zone);
-  case precision::second: return sys_time_info_impl<duration::seconds>(fields, zone);
-  case precision::millisecond: return sys_time_info_impl<duration::milliseconds>(fields, zone);
-  case precision::microsecond: return sys_time_info_impl<duration::microseconds>(fields, zone);
-  case precision::nanosecond: return sys_time_info_impl<duration::nanoseconds>(fields, zone);
+  case precision::day: return sys_time_info_impl<duration::days>(fields, zone, columns);
+  case precision::second: return sys_time_info_impl<duration::seconds>(fields, zone, columns);
+  case precision::millisecond: return sys_time_info_impl<duration::milliseconds>(fields, zone, columns);
+  case precision::microsecond: return sys_time_info_impl<duration::microseconds>(fields, zone, columns);
+  case precision::nanosecond: return sys_time_info_impl<duration::nanoseconds>(fields, zone, columns);
   default: clock_abort("Internal error: Should never be called.");
   }
 }
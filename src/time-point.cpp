@@ -4,9 +4,12 @@
 #include "rcrd.h"
 #include "duration.h"
 #include "parse.h"
+#include "parse-program.h"
+#include "parse-memo.h"
 #include "failure.h"
 #include "fill.h"
-#include <sstream>
+#include <algorithm>
+#include <vector>
 
 [[cpp11::register]]
 SEXP
@@ -87,47 +90,35 @@ time_point_restore(SEXP x, SEXP to) {
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Returns the index of the format that parsed `p_elt`, or `-1` on failure
+ */
 template <class ClockDuration, class Clock>
 static
 inline
-void
-time_point_parse_one(std::istringstream& stream,
-                     const std::vector<std::string>& fmts,
-                     const std::pair<const std::string*, const std::string*>& month_names_pair,
-                     const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                     const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                     const char& dmark,
+r_ssize
+time_point_parse_one(rclock::parse_stream& stream,
+                     const char* p_elt,
+                     rclock::parse_programs& programs,
                      const r_ssize& i,
                      rclock::failures& fail,
-                     ClockDuration& out) {
+                     int64_t& out) {
   using Duration = typename ClockDuration::chrono_duration;
-  const r_ssize size = fmts.size();
 
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
+  const r_ssize n_programs = programs.size();
 
-    const char* fmt = fmts[j].c_str();
+  for (r_ssize k = 0; k < n_programs; ++k) {
     std::chrono::time_point<Clock, Duration> tp;
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
-      tp
-    );
-
-    if (!stream.fail()) {
-      out.assign(tp.time_since_epoch(), i);
-      return;
+    if (programs[k].parse(stream, p_elt, tp)) {
+      out = static_cast<int64_t>(tp.time_since_epoch().count());
+      return programs.hit(k);
     }
   }
 
   fail.write(i);
-  out.assign_na(i);
+  out = rclock::duration::block_na;
+  return -1;
 }
 
 template <class ClockDuration, class Clock>
@@ -174,43 +165,96 @@ time_point_parse_impl(const cpp11::strings& x,
     ampm_names
   );
 
+  rclock::parse_programs programs(
+    fmts,
+    month_names_pair,
+    weekday_names_pair,
+    ampm_names_pair,
+    dmark
+  );
+
   rclock::failures fail{};
 
-  std::istringstream stream;
+  rclock::parse_stream stream;
+
+  rclock::parse_memo<int64_t> memo;
+
+  using Duration = typename ClockDuration::chrono_duration;
+  using Rep = typename Duration::rep;
+
+  // Results are collected into a block of packed values and written out to
+  // `out` a block at a time
+  int64_t block[rclock::duration::block_size];
+
+  // Locations that parsed to the smallest value, which `assign_block()` would
+  // take as missing, see `block_na`
+  std::vector<r_ssize> mins;
 
   void* vmax = vmaxget();
 
-  for (r_ssize i = 0; i < size; ++i) {
-    const SEXP elt = x[i];
+  for (r_ssize start = 0; start < size; start += rclock::duration::block_size) {
+    const r_ssize n = std::min(rclock::duration::block_size, size - start);
+
+    for (r_ssize k = 0; k < n; ++k) {
+      const r_ssize i = start + k;
+      const SEXP elt = x[i];
+
+      if (elt == r_chr_na) {
+        block[k] = rclock::duration::block_na;
+        continue;
+      }
+
+      const rclock::parse_memo<int64_t>::entry* p_memo = memo.find(elt);
+
+      if (p_memo != NULL) {
+        block[k] = p_memo->value;
+        if (p_memo->format == -1) {
+          fail.write(i);
+        } else {
+          programs.repeat(p_memo->format);
+          if (block[k] == rclock::duration::block_na) {
+            mins.push_back(i);
+          }
+        }
+        continue;
+      }
+
+      const char* p_elt = Rf_translateCharUTF8(elt);
+
+      const r_ssize format = time_point_parse_one<ClockDuration, Clock>(
+        stream,
+        p_elt,
+        programs,
+        i,
+        fail,
+        block[k]
+      );
+
+      memo.insert(elt, block[k], format);
+
+      if (format != -1 && block[k] == rclock::duration::block_na) {
+        mins.push_back(i);
+      }
+
+      // Release the translation of `elt`, if it needed one
+      vmaxset(vmax);
+    }
+
+    out.assign_block(block, start, n);
 
-    if (elt == r_chr_na) {
-      out.assign_na(i);
-      continue;
+    for (const r_ssize i : mins) {
+      out.assign(Duration{static_cast<Rep>(rclock::duration::block_na)}, i);
     }
 
-    const char* p_elt = Rf_translateCharUTF8(elt);
-
-    stream.str(p_elt);
-
-    time_point_parse_one<ClockDuration, Clock>(
-      stream,
-      fmts,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
-      i,
-      fail,
-      out
-    );
+    mins.clear();
   }
 
-  vmaxset(vmax);
-
   if (fail.any_failures()) {
     fail.warn_parse();
   }
 
+  programs.signal_hits();
+
   return out.to_list();
 }
 
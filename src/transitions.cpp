@@ -0,0 +1,386 @@
+#include "transitions.h"
+#include <algorithm>
+#include <unordered_map>
+#include <memory>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+// -----------------------------------------------------------------------------
+
+namespace rclock {
+
+/*
+ * Periods are materialized starting from the one in effect at `table_lower()`
+ * (which usually extends back to the beginning of time, as it is the zone's
+ * LMT period) and stopping at the first period that reaches `table_upper()`.
+ * Zones with active daylight saving time rules have transitions forever, so we
+ * have to stop somewhere. Lookups past the end fall back to `tzdb::`.
+ */
+static
+inline
+date::sys_seconds
+table_lower() {
+  return date::sys_days{date::year{1800} / date::January / 1};
+}
+
+static
+inline
+date::sys_seconds
+table_upper() {
+  return date::sys_days{date::year{2200} / date::January / 1};
+}
+
+transitions::transitions() noexcept
+  : end_(0),
+    max_abs_offset_(0)
+  {}
+
+transitions::transitions(const date::time_zone* p_time_zone)
+  : end_(0),
+    max_abs_offset_(0) {
+  const date::sys_seconds upper = table_upper();
+
+  date::sys_seconds ss = table_lower();
+  date::sys_info info;
+
+  if (!tzdb::get_sys_info(ss, p_time_zone, info)) {
+    return;
+  }
+
+  while (true) {
+    if (!begin_.empty() && info.begin.time_since_epoch().count() != end_) {
+      // Periods are expected to be contiguous. If they aren't, give up and
+      // leave all lookups to `tzdb::`.
+      *this = transitions();
+      return;
+    }
+
+    r_ssize abbrev_index = 0;
+    const r_ssize n_abbrevs = static_cast<r_ssize>(abbrevs_.size());
+
+    while (abbrev_index < n_abbrevs && abbrevs_[abbrev_index] != info.abbrev) {
+      ++abbrev_index;
+    }
+    if (abbrev_index == n_abbrevs) {
+      abbrevs_.push_back(info.abbrev);
+    }
+
+    const int64_t offset = info.offset.count();
+
+    begin_.push_back(info.begin.time_since_epoch().count());
+    offset_.push_back(static_cast<int32_t>(offset));
+    save_.push_back(static_cast<int32_t>(info.save.count()));
+    abbrev_index_.push_back(static_cast<uint16_t>(abbrev_index));
+    end_ = info.end.time_since_epoch().count();
+    max_abs_offset_ = std::max(max_abs_offset_, std::abs(offset));
+
+    if (info.end >= upper || info.end <= ss) {
+      break;
+    }
+
+    ss = info.end;
+
+    if (!tzdb::get_sys_info(ss, p_time_zone, info)) {
+      *this = transitions();
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Raw binary serialization. Cache files are only meant to be shared between
+ * processes on the same machine, so values are written in native byte order
+ * and the file header records enough to reject files from anywhere else.
+ */
+
+template <class T>
+static
+inline
+void
+write_value(std::ostream& stream, const T& x) {
+  stream.write(reinterpret_cast<const char*>(&x), sizeof(T));
+}
+
+template <class T>
+static
+inline
+bool
+read_value(std::istream& stream, T& x) {
+  stream.read(reinterpret_cast<char*>(&x), sizeof(T));
+  return static_cast<bool>(stream);
+}
+
+// Guards against allocating absurd amounts of memory for a corrupt file
+static const uint32_t SERIALIZED_SIZE_MAX = 1u << 24;
+
+template <class T>
+static
+inline
+void
+write_vector(std::ostream& stream, const std::vector<T>& x) {
+  const uint32_t size = static_cast<uint32_t>(x.size());
+  write_value(stream, size);
+  stream.write(reinterpret_cast<const char*>(x.data()), size * sizeof(T));
+}
+
+template <class T>
+static
+inline
+bool
+read_vector(std::istream& stream, std::vector<T>& x) {
+  uint32_t size;
+  if (!read_value(stream, size) || size > SERIALIZED_SIZE_MAX) {
+    return false;
+  }
+  x.resize(size);
+  stream.read(reinterpret_cast<char*>(x.data()), size * sizeof(T));
+  return static_cast<bool>(stream);
+}
+
+static
+inline
+void
+write_string(std::ostream& stream, const std::string& x) {
+  const uint32_t size = static_cast<uint32_t>(x.size());
+  write_value(stream, size);
+  stream.write(x.data(), size);
+}
+
+static
+inline
+bool
+read_string(std::istream& stream, std::string& x) {
+  uint32_t size;
+  if (!read_value(stream, size) || size > SERIALIZED_SIZE_MAX) {
+    return false;
+  }
+  x.resize(size);
+  stream.read(&x[0], size);
+  return static_cast<bool>(stream);
+}
+
+void
+transitions::write(std::ostream& stream) const {
+  write_vector(stream, begin_);
+  write_vector(stream, offset_);
+  write_vector(stream, save_);
+  write_vector(stream, abbrev_index_);
+
+  const uint32_t n_abbrevs = static_cast<uint32_t>(abbrevs_.size());
+  write_value(stream, n_abbrevs);
+  for (uint32_t i = 0; i < n_abbrevs; ++i) {
+    write_string(stream, abbrevs_[i]);
+  }
+
+  write_value(stream, end_);
+}
+
+/*
+ * Returns `false` if the table couldn't be read or isn't internally
+ * consistent, in which case `*this` is left empty.
+ */
+bool
+transitions::read(std::istream& stream) {
+  *this = transitions();
+
+  transitions out;
+  uint32_t n_abbrevs;
+
+  if (!read_vector(stream, out.begin_) ||
+      !read_vector(stream, out.offset_) ||
+      !read_vector(stream, out.save_) ||
+      !read_vector(stream, out.abbrev_index_) ||
+      !read_value(stream, n_abbrevs) ||
+      n_abbrevs > SERIALIZED_SIZE_MAX) {
+    return false;
+  }
+
+  out.abbrevs_.resize(n_abbrevs);
+  for (uint32_t i = 0; i < n_abbrevs; ++i) {
+    if (!read_string(stream, out.abbrevs_[i])) {
+      return false;
+    }
+  }
+
+  if (!read_value(stream, out.end_)) {
+    return false;
+  }
+
+  const size_t size = out.begin_.size();
+
+  if (out.offset_.size() != size ||
+      out.save_.size() != size ||
+      out.abbrev_index_.size() != size) {
+    return false;
+  }
+
+  for (size_t k = 0; k < size; ++k) {
+    if (out.abbrev_index_[k] >= n_abbrevs) {
+      return false;
+    }
+    const int64_t end = (k + 1 < size) ? out.begin_[k + 1] : out.end_;
+    if (out.begin_[k] >= end) {
+      return false;
+    }
+    const int64_t offset = out.offset_[k];
+    out.max_abs_offset_ = std::max(out.max_abs_offset_, std::abs(offset));
+  }
+
+  *this = std::move(out);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Tables read from a cache file, keyed by zone name. They are moved into the
+ * pointer keyed cache the first time their zone is actually used.
+ */
+static
+std::unordered_map<std::string, std::unique_ptr<transitions>>&
+transitions_precompiled() {
+  static std::unordered_map<std::string, std::unique_ptr<transitions>> out;
+  return out;
+}
+
+namespace detail {
+
+static const transitions transitions_empty{};
+
+const date::time_zone* p_transitions_time_zone_last = NULL;
+const transitions* p_transitions_last = &transitions_empty;
+
+const transitions&
+get_transitions_slow(const date::time_zone* p_time_zone) {
+  // Once per session, never cleared as `time_zone` pointers are stable
+  static std::unordered_map<const date::time_zone*, std::unique_ptr<transitions>> cache;
+
+  auto it = cache.find(p_time_zone);
+
+  if (it == cache.end()) {
+    std::unique_ptr<transitions> p_transitions;
+
+    auto& precompiled = transitions_precompiled();
+    auto it_precompiled = (p_time_zone == NULL) ? precompiled.end() : precompiled.find(p_time_zone->name());
+
+    if (it_precompiled != precompiled.end()) {
+      p_transitions = std::move(it_precompiled->second);
+      precompiled.erase(it_precompiled);
+    } else {
+      p_transitions.reset(new transitions(p_time_zone));
+    }
+
+    it = cache.emplace(p_time_zone, std::move(p_transitions)).first;
+  }
+
+  p_transitions_time_zone_last = p_time_zone;
+  p_transitions_last = it->second.get();
+
+  return *p_transitions_last;
+}
+
+} // namespace detail
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Cache file layout:
+ * - Magic bytes, `CLOCKTZ` followed by a format version byte
+ * - A byte order marker and `sizeof(r_ssize)`, to reject foreign files
+ * - The tzdb version the tables were built from
+ * - The number of zones, followed by each zone's name and table
+ */
+static const char CACHE_MAGIC[8] = {'C', 'L', 'O', 'C', 'K', 'T', 'Z', '1'};
+static const uint32_t CACHE_BYTE_ORDER = 0x01020304;
+
+/*
+ * Read the tables of a cache file into the precompiled store, reporting the
+ * names of the zones that were read. Returns `false` without reading anything
+ * if the file is missing, corrupt, or was built from a different tzdb version.
+ * Zones that have already been used this session keep their existing table.
+ */
+bool
+transitions_cache_read(const std::string& path,
+                       const std::string& version,
+                       std::vector<std::string>& names) {
+  std::ifstream stream(path, std::ios::in | std::ios::binary);
+
+  if (!stream) {
+    return false;
+  }
+
+  char magic[sizeof(CACHE_MAGIC)];
+  stream.read(magic, sizeof(magic));
+  if (!stream || std::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0) {
+    return false;
+  }
+
+  uint32_t byte_order;
+  uint32_t ssize_size;
+  std::string file_version;
+  uint32_t n_zones;
+
+  if (!read_value(stream, byte_order) || byte_order != CACHE_BYTE_ORDER ||
+      !read_value(stream, ssize_size) || ssize_size != sizeof(r_ssize) ||
+      !read_string(stream, file_version) || file_version != version ||
+      !read_value(stream, n_zones) || n_zones > SERIALIZED_SIZE_MAX) {
+    return false;
+  }
+
+  // Read everything before touching the store, so a truncated file is ignored
+  // as a whole
+  std::vector<std::string> file_names(n_zones);
+  std::vector<std::unique_ptr<transitions>> file_tables(n_zones);
+
+  for (uint32_t i = 0; i < n_zones; ++i) {
+    file_tables[i].reset(new transitions());
+
+    if (!read_string(stream, file_names[i]) || !file_tables[i]->read(stream)) {
+      return false;
+    }
+  }
+
+  auto& precompiled = transitions_precompiled();
+
+  for (uint32_t i = 0; i < n_zones; ++i) {
+    precompiled[file_names[i]] = std::move(file_tables[i]);
+  }
+
+  names = std::move(file_names);
+
+  return true;
+}
+
+bool
+transitions_cache_write(const std::string& path,
+                        const std::string& version,
+                        const std::vector<const date::time_zone*>& zones) {
+  std::ofstream stream(path, std::ios::out | std::ios::binary | std::ios::trunc);
+
+  if (!stream) {
+    return false;
+  }
+
+  stream.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  write_value(stream, CACHE_BYTE_ORDER);
+  write_value(stream, static_cast<uint32_t>(sizeof(r_ssize)));
+  write_string(stream, version);
+
+  const uint32_t n_zones = static_cast<uint32_t>(zones.size());
+  write_value(stream, n_zones);
+
+  for (uint32_t i = 0; i < n_zones; ++i) {
+    const date::time_zone* p_time_zone = zones[i];
+    write_string(stream, p_time_zone->name());
+    get_transitions(p_time_zone).write(stream);
+  }
+
+  stream.close();
+
+  return !stream.fail();
+}
+
+} // namespace rclock
@@ -0,0 +1,306 @@
+#ifndef CLOCK_TRANSITIONS_H
+#define CLOCK_TRANSITIONS_H
+
+#include "clock.h"
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <iosfwd>
+
+// -----------------------------------------------------------------------------
+
+namespace rclock {
+
+/*
+ * A flattened copy of the `sys_info` periods of a single time zone.
+ *
+ * Looking up a `sys_info` or `local_info` through `tzdb::` re-walks the zone's
+ * rule machinery every time. Instead, the first time we see a zone we walk its
+ * periods once and store them in flat sorted arrays, which lets us answer
+ * lookups with a binary search over `begin_`.
+ *
+ * Period `k` covers `[begin_[k], begin_[k + 1])`, and the last period ends at
+ * `end_`. Lookups outside of `[begin_[0], end_)` return `false`, and the caller
+ * is expected to fall back to `tzdb::`. This happens for zones with rules that
+ * never stop producing transitions once we get past `table_upper()`, and for
+ * zones we couldn't materialize at all.
+ */
+class transitions
+{
+  std::vector<int64_t> begin_;
+  std::vector<int32_t> offset_;
+  std::vector<int32_t> save_;
+  std::vector<uint16_t> abbrev_index_;
+  std::vector<std::string> abbrevs_;
+  int64_t end_;
+  int64_t max_abs_offset_;
+
+public:
+  transitions() noexcept;
+  transitions(const date::time_zone* p_time_zone);
+
+  r_ssize size() const noexcept;
+
+  bool is_fixed() const noexcept;
+  std::chrono::seconds fixed_offset() const noexcept;
+  date::sys_info fixed_info() const;
+
+  bool get_sys_info(const date::sys_seconds& ss, date::sys_info& info) const;
+  bool get_local_info(const date::local_seconds& ls, date::local_info& info) const;
+  bool get_local_info(const date::local_seconds& ls,
+                      date::local_info& info,
+                      int64_t& lower,
+                      int64_t& upper) const;
+
+  void write(std::ostream& stream) const;
+  bool read(std::istream& stream);
+
+private:
+  r_ssize locate(int64_t x) const noexcept;
+  int64_t end(r_ssize k) const noexcept;
+  date::sys_info sys_info(r_ssize k) const;
+};
+
+namespace detail {
+
+extern const date::time_zone* p_transitions_time_zone_last;
+extern const transitions* p_transitions_last;
+
+const transitions& get_transitions_slow(const date::time_zone* p_time_zone);
+
+} // namespace detail
+
+bool transitions_cache_read(const std::string& path,
+                            const std::string& version,
+                            std::vector<std::string>& names);
+
+bool transitions_cache_write(const std::string& path,
+                             const std::string& version,
+                             const std::vector<const date::time_zone*>& zones);
+
+/*
+ * Retrieve the process wide transition table of `p_time_zone`, building it on
+ * first use. Per-element loops tend to ask for the same zone over and over, so
+ * the most recently used table is checked before hitting the cache.
+ */
+static
+inline
+const transitions&
+get_transitions(const date::time_zone* p_time_zone) {
+  if (p_time_zone == detail::p_transitions_time_zone_last) {
+    return *detail::p_transitions_last;
+  }
+  return detail::get_transitions_slow(p_time_zone);
+}
+
+// -----------------------------------------------------------------------------
+
+inline
+r_ssize
+transitions::size() const noexcept {
+  return static_cast<r_ssize>(begin_.size());
+}
+
+/*
+ * Zones like UTC, or Etc/GMT+5, consist of a single period with a constant
+ * offset and no transitions. Kernels can use this to skip the lookup entirely
+ * and apply `fixed_offset()` to every element.
+ *
+ * A single period in the table isn't enough on its own, as the table only
+ * covers the range it was materialized over. The period also has to span all
+ * of time, like the one `tzdb::` reports for a fixed offset zone, for it to be
+ * the zone's only period.
+ */
+inline
+bool
+transitions::is_fixed() const noexcept {
+  if (size() != 1) {
+    return false;
+  }
+
+  const int64_t lower = date::sys_seconds{
+    date::sys_days{date::year::min() / date::January / 1}
+  }.time_since_epoch().count();
+
+  const int64_t upper = date::sys_seconds{
+    date::sys_days{date::year::max() / date::December / 31}
+  }.time_since_epoch().count();
+
+  return begin_[0] <= lower && end_ >= upper;
+}
+
+inline
+std::chrono::seconds
+transitions::fixed_offset() const noexcept {
+  return std::chrono::seconds{offset_[0]};
+}
+
+inline
+date::sys_info
+transitions::fixed_info() const {
+  return sys_info(0);
+}
+
+/*
+ * Index of the period containing `x`, i.e. the last `k` with
+ * `begin_[k] <= x`. Assumes `begin_[0] <= x`.
+ *
+ * Written so that the loop body compiles down to a conditional move rather
+ * than an unpredictable branch.
+ */
+inline
+r_ssize
+transitions::locate(int64_t x) const noexcept {
+  const int64_t* p_base = begin_.data();
+  r_ssize n = size();
+
+  while (n > 1) {
+    const r_ssize half = n / 2;
+    p_base = (p_base[half] <= x) ? p_base + half : p_base;
+    n -= half;
+  }
+
+  return p_base - begin_.data();
+}
+
+inline
+int64_t
+transitions::end(r_ssize k) const noexcept {
+  return (k + 1 < size()) ? begin_[k + 1] : end_;
+}
+
+inline
+date::sys_info
+transitions::sys_info(r_ssize k) const {
+  date::sys_info out;
+  out.begin = date::sys_seconds{std::chrono::seconds{begin_[k]}};
+  out.end = date::sys_seconds{std::chrono::seconds{end(k)}};
+  out.offset = std::chrono::seconds{offset_[k]};
+  out.save = std::chrono::minutes{save_[k]};
+  out.abbrev = abbrevs_[abbrev_index_[k]];
+  return out;
+}
+
+inline
+bool
+transitions::get_sys_info(const date::sys_seconds& ss, date::sys_info& info) const {
+  const int64_t x = ss.time_since_epoch().count();
+
+  if (begin_.empty() || x < begin_[0] || x >= end_) {
+    return false;
+  }
+
+  info = sys_info(locate(x));
+
+  return true;
+}
+
+/*
+ * Period `k` contains local time `x` when `begin_[k] <= x - offset_[k] < end(k)`.
+ *
+ * Since `|offset_[k]| <= max_abs_offset_`, any such period must overlap
+ * `[x - max_abs_offset_, x + max_abs_offset_]`, which is typically only one or
+ * two periods wide. We check all of them:
+ * - One match is a unique local time.
+ * - Two matches is an ambiguous local time, i.e. the local time was repeated.
+ * - No matches is a nonexistent local time, i.e. it fell into a gap.
+ */
+inline
+bool
+transitions::get_local_info(const date::local_seconds& ls, date::local_info& info) const {
+  int64_t lower;
+  int64_t upper;
+  return get_local_info(ls, info, lower, upper);
+}
+
+/*
+ * Also reports the range of local seconds, `[lower, upper)`, that would result
+ * in the exact same `info`. This is only computed for unique local times, as
+ * they are the only ones worth reusing. For ambiguous and nonexistent local
+ * times the range is just `[x, x + 1)`.
+ */
+inline
+bool
+transitions::get_local_info(const date::local_seconds& ls,
+                            date::local_info& info,
+                            int64_t& lower,
+                            int64_t& upper) const {
+  const int64_t x = ls.time_since_epoch().count();
+
+  if (begin_.empty()) {
+    return false;
+  }
+
+  // Written to avoid overflow, as the outer bounds can be extreme
+  const int64_t local_min = begin_[0] + max_abs_offset_;
+  const int64_t local_max = end_ - max_abs_offset_;
+
+  if (x < local_min || x >= local_max) {
+    return false;
+  }
+
+  const r_ssize window_lower = locate(x - max_abs_offset_);
+  const r_ssize window_upper = locate(x + max_abs_offset_);
+
+  r_ssize first = -1;
+  r_ssize second = -1;
+
+  for (r_ssize k = window_lower; k <= window_upper; ++k) {
+    const int64_t elt = x - offset_[k];
+
+    if (begin_[k] <= elt && elt < end(k)) {
+      if (first == -1) {
+        first = k;
+      } else if (second == -1) {
+        second = k;
+      }
+    }
+  }
+
+  lower = x;
+  upper = x + 1;
+
+  if (first != -1 && second == -1) {
+    info.result = date::local_info::unique;
+    info.first = sys_info(first);
+    info.second = date::sys_info{};
+
+    // Shrink the local range of `first` by the local ranges of any neighbors
+    // that overlap it. Only neighbors within `2 * max_abs_offset_` can.
+    lower = (first == 0) ? local_min : std::max(local_min, begin_[first] + offset_[first]);
+    upper = (first == size() - 1) ? local_max : std::min(local_max, end(first) + offset_[first]);
+
+    for (r_ssize k = first - 1; k >= 0 && end(k) > begin_[first] - 2 * max_abs_offset_; --k) {
+      lower = std::max(lower, end(k) + offset_[k]);
+    }
+    for (r_ssize k = first + 1; k < size() && begin_[k] < end(first) + 2 * max_abs_offset_; ++k) {
+      upper = std::min(upper, begin_[k] + offset_[k]);
+    }
+
+    return true;
+  }
+
+  if (second != -1) {
+    info.result = date::local_info::ambiguous;
+    info.first = sys_info(first);
+    info.second = sys_info(second);
+    return true;
+  }
+
+  for (r_ssize k = window_lower; k < window_upper; ++k) {
+    if (x - offset_[k] >= end(k) && x - offset_[k + 1] < begin_[k + 1]) {
+      info.result = date::local_info::nonexistent;
+      info.first = sys_info(k);
+      info.second = sys_info(k + 1);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+} // namespace rclock
+
+// -----------------------------------------------------------------------------
+
+#endif
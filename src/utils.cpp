@@ -24,6 +24,7 @@ SEXP syms_start = NULL;
 SEXP syms_clock = NULL;
 SEXP syms_zone = NULL;
 SEXP syms_set_names = NULL;
+SEXP syms_clock_parse_format_hits = NULL;
 
 SEXP classes_duration = NULL;
 SEXP classes_sys_time = NULL;
@@ -103,6 +104,7 @@ clock_init_utils() {
   syms_clock = Rf_install("clock");
   syms_zone = Rf_install("zone");
   syms_set_names = Rf_install("names<-");
+  syms_clock_parse_format_hits = Rf_install("clock.parse_format_hits");
 
 
   classes_duration = Rf_allocVector(STRSXP, 4);
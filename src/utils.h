@@ -2,6 +2,7 @@
 #define CLOCK_UTILS_H
 
 #include "clock.h"
+#include "transitions.h"
 #include <cstdint>
 #include <cmath>
 #include <cstdarg> // For `va_start()` and `va_end()`
@@ -17,6 +18,7 @@ extern SEXP syms_start;
 extern SEXP syms_clock;
 extern SEXP syms_zone;
 extern SEXP syms_set_names;
+extern SEXP syms_clock_parse_format_hits;
 
 extern SEXP classes_duration;
 extern SEXP classes_sys_time;
@@ -41,7 +43,8 @@ namespace detail {
 } // namespace detail
 
 // Essentially date's `time_zone::get_info(sys_time<Duration> st)`, but goes
-// through `tzdb::` to get the sys_info
+// through the zone's flattened transition table, falling back to `tzdb::` when
+// `tp` is outside the range of the table
 template <class Duration>
 static
 inline
@@ -52,6 +55,10 @@ get_info(const date::sys_time<Duration>& tp, const date::time_zone* p_time_zone)
 
   date::sys_info info;
 
+  if (rclock::get_transitions(p_time_zone).get_sys_info(ss, info)) {
+    return info;
+  }
+
   if (!tzdb::get_sys_info(ss, p_time_zone, info)) {
     cpp11::stop("Can't lookup sys information for the supplied time zone.");
   }
@@ -60,7 +67,8 @@ get_info(const date::sys_time<Duration>& tp, const date::time_zone* p_time_zone)
 }
 
 // Essentially date's `time_zone::get_info(local_time<Duration> lt)`, but goes
-// through `tzdb::` to get the local_info
+// through the zone's flattened transition table, falling back to `tzdb::` when
+// `tp` is outside the range of the table
 template <class Duration>
 static
 inline
@@ -71,6 +79,10 @@ get_info(const date::local_time<Duration>& tp, const date::time_zone* p_time_zon
 
   date::local_info info;
 
+  if (rclock::get_transitions(p_time_zone).get_local_info(ls, info)) {
+    return info;
+  }
+
   if (!tzdb::get_local_info(ls, p_time_zone, info)) {
     cpp11::stop("Can't lookup local information for the supplied time zone.");
   }
@@ -79,7 +91,7 @@ get_info(const date::local_time<Duration>& tp, const date::time_zone* p_time_zon
 }
 
 // Essentially date's `time_zone::to_local(sys_time<Duration> tp)`, but goes
-// through `tzdb::` to get the sys_info
+// through `rclock::get_info()` to get the sys_info
 template <class Duration>
 static
 inline
@@ -0,0 +1,146 @@
+#ifndef CLOCK_ZONE_CURSOR_H
+#define CLOCK_ZONE_CURSOR_H
+
+#include "clock.h"
+#include "utils.h"
+#include "transitions.h"
+#include <limits>
+
+// -----------------------------------------------------------------------------
+
+namespace rclock {
+
+/*
+ * A `zone_cursor` remembers the last `sys_info` and `local_info` that it looked
+ * up, along with the range of seconds that they are valid for. Most real inputs
+ * are sorted or clustered, so consecutive elements typically fall in the same
+ * period and the lookup reduces to two comparisons. A fresh lookup through
+ * `rclock::get_info()` is only done when an element leaves the cached range.
+ *
+ * The returned references are only valid until the next lookup.
+ */
+class zone_cursor
+{
+  const date::time_zone* p_time_zone_;
+
+  date::sys_info sys_info_;
+  int64_t sys_lower_;
+  int64_t sys_upper_;
+
+  date::local_info local_info_;
+  int64_t local_lower_;
+  int64_t local_upper_;
+
+public:
+  zone_cursor(const date::time_zone* p_time_zone) noexcept;
+
+  void reset(const date::time_zone* p_time_zone) noexcept;
+  const date::time_zone* time_zone() const noexcept;
+
+  template <class Duration>
+  const date::sys_info& get_info(const date::sys_time<Duration>& tp);
+
+  template <class Duration>
+  const date::local_info& get_info(const date::local_time<Duration>& tp);
+
+  template <class Duration>
+  date::local_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+  get_local_time(const date::sys_time<Duration>& tp);
+
+private:
+  void invalidate() noexcept;
+};
+
+inline
+zone_cursor::zone_cursor(const date::time_zone* p_time_zone) noexcept
+  : p_time_zone_(p_time_zone) {
+  invalidate();
+}
+
+/*
+ * Switch the cursor over to a new time zone. Cheap to call per element, as it
+ * only drops the cached info when the zone actually changes.
+ */
+inline
+void
+zone_cursor::reset(const date::time_zone* p_time_zone) noexcept {
+  if (p_time_zone == p_time_zone_) {
+    return;
+  }
+  p_time_zone_ = p_time_zone;
+  invalidate();
+}
+
+inline
+const date::time_zone*
+zone_cursor::time_zone() const noexcept {
+  return p_time_zone_;
+}
+
+inline
+void
+zone_cursor::invalidate() noexcept {
+  // An empty range that nothing can fall in
+  sys_lower_ = std::numeric_limits<int64_t>::max();
+  sys_upper_ = std::numeric_limits<int64_t>::min();
+  local_lower_ = std::numeric_limits<int64_t>::max();
+  local_upper_ = std::numeric_limits<int64_t>::min();
+}
+
+template <class Duration>
+inline
+const date::sys_info&
+zone_cursor::get_info(const date::sys_time<Duration>& tp) {
+  const date::sys_seconds ss = date::floor<std::chrono::seconds>(tp);
+  const int64_t x = ss.time_since_epoch().count();
+
+  if (sys_lower_ <= x && x < sys_upper_) {
+    return sys_info_;
+  }
+
+  sys_info_ = rclock::get_info(ss, p_time_zone_);
+  sys_lower_ = sys_info_.begin.time_since_epoch().count();
+  sys_upper_ = sys_info_.end.time_since_epoch().count();
+
+  return sys_info_;
+}
+
+template <class Duration>
+inline
+const date::local_info&
+zone_cursor::get_info(const date::local_time<Duration>& tp) {
+  const date::local_seconds ls = date::floor<std::chrono::seconds>(tp);
+  const int64_t x = ls.time_since_epoch().count();
+
+  if (local_lower_ <= x && x < local_upper_) {
+    return local_info_;
+  }
+
+  const transitions& table = rclock::get_transitions(p_time_zone_);
+
+  if (table.get_local_info(ls, local_info_, local_lower_, local_upper_)) {
+    return local_info_;
+  }
+
+  // Outside the range of the table, don't reuse the result
+  local_info_ = rclock::get_info(ls, p_time_zone_);
+  local_lower_ = std::numeric_limits<int64_t>::max();
+  local_upper_ = std::numeric_limits<int64_t>::min();
+
+  return local_info_;
+}
+
+template <class Duration>
+inline
+date::local_time<typename std::common_type<Duration, std::chrono::seconds>::type>
+zone_cursor::get_local_time(const date::sys_time<Duration>& tp) {
+  using LT = date::local_time<typename std::common_type<Duration, std::chrono::seconds>::type>;
+  const date::sys_info& info = get_info(tp);
+  return LT{(tp + info.offset).time_since_epoch()};
+}
+
+} // namespace rclock
+
+// -----------------------------------------------------------------------------
+
+#endif
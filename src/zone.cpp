@@ -1,6 +1,10 @@
 #include "zone.h"
 #include "utils.h"
+#include "duration.h"
+#include "info.h"
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /*
  * Brought over from lubridate/timechange
@@ -11,22 +15,145 @@
 
 [[cpp11::register]]
 cpp11::writable::logicals zone_is_valid(const cpp11::strings& zone) {
+  const r_ssize size = zone.size();
+  cpp11::writable::logicals out(size);
+
+  rclock::zone_cache cache;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const SEXP elt = zone[i];
+
+    if (elt == r_chr_na) {
+      out[i] = cpp11::r_bool(false);
+      continue;
+    }
+
+    // Local time
+    if (CHAR(elt)[0] == '\0') {
+      out[i] = cpp11::r_bool(true);
+      continue;
+    }
+
+    const date::time_zone* p_time_zone;
+    out[i] = cpp11::r_bool(cache.try_load(elt, p_time_zone));
+  }
+
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * All of the periods of `zone` that overlap `[from, to)`, as `sys_info`
+ * columns. Consecutive periods are found by jumping straight to the `end` of
+ * the previous one, so this costs one lookup per transition rather than one
+ * per element of the range.
+ */
+[[cpp11::register]]
+cpp11::writable::list
+zone_transitions_cpp(const cpp11::strings& zone,
+                     cpp11::list_of<cpp11::doubles> from,
+                     cpp11::list_of<cpp11::doubles> to) {
   zone_size_validate(zone);
+  const std::string zone_name = cpp11::r_string(zone[0]);
+  const date::time_zone* p_time_zone = zone_name_load(zone_name);
 
-  cpp11::r_string zone_name_r(zone[0]);
-  std::string zone_name(zone_name_r);
+  const rclock::duration::seconds x_from{from};
+  const rclock::duration::seconds x_to{to};
 
-  // Local time
-  if (zone_name.size() == 0) {
-    return cpp11::writable::logicals({cpp11::r_bool(true)});
+  const date::sys_seconds lower{x_from[0]};
+  const date::sys_seconds upper{x_to[0]};
+
+  std::vector<date::sys_info> infos;
+
+  date::sys_seconds ss = lower;
+
+  while (ss < upper) {
+    date::sys_info info = rclock::get_info(ss, p_time_zone);
+    const date::sys_seconds end = info.end;
+
+    infos.push_back(std::move(info));
+
+    if (end <= ss) {
+      // Last period, guard against a zero width period that would never end
+      break;
+    }
+
+    ss = end;
   }
 
-  const date::time_zone* p_time_zone;
+  const r_ssize size = static_cast<r_ssize>(infos.size());
+  rclock::sys_info_columns out(size);
 
-  if (tzdb::locate_zone(zone_name, p_time_zone)) {
-    return cpp11::writable::logicals({cpp11::r_bool(true)});
-  } else {
-    return cpp11::writable::logicals({cpp11::r_bool(false)});
+  for (r_ssize i = 0; i < size; ++i) {
+    out.assign(infos[i], i);
+  }
+
+  return out.to_list();
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Loads each zone, building its transition table unless it came from a cache
+ * file. Returns the canonical name of each zone, which is what the cache is
+ * keyed by, so link names and `""` can be checked against a cache's contents.
+ */
+[[cpp11::register]]
+cpp11::writable::strings zone_preload_cpp(const cpp11::strings& zones) {
+  const r_ssize size = zones.size();
+  cpp11::writable::strings out(size);
+
+  rclock::zone_cache cache;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const date::time_zone* p_time_zone = cache.load(zones[i]);
+    out[i] = p_time_zone->name();
+  }
+
+  return out;
+}
+
+[[cpp11::register]]
+cpp11::writable::strings zone_cache_read_cpp(const cpp11::strings& path,
+                                             const cpp11::strings& version) {
+  const std::string path_string = cpp11::r_string(path[0]);
+  const std::string version_string = cpp11::r_string(version[0]);
+
+  std::vector<std::string> names;
+
+  if (!rclock::transitions_cache_read(path_string, version_string, names)) {
+    return cpp11::writable::strings();
+  }
+
+  const r_ssize size = static_cast<r_ssize>(names.size());
+  cpp11::writable::strings out(size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    out[i] = names[i];
+  }
+
+  return out;
+}
+
+[[cpp11::register]]
+void zone_cache_write_cpp(const cpp11::strings& path,
+                          const cpp11::strings& zones,
+                          const cpp11::strings& version) {
+  const std::string path_string = cpp11::r_string(path[0]);
+  const std::string version_string = cpp11::r_string(version[0]);
+
+  const r_ssize size = zones.size();
+  std::vector<const date::time_zone*> time_zones(size);
+
+  rclock::zone_cache cache;
+
+  for (r_ssize i = 0; i < size; ++i) {
+    time_zones[i] = cache.load(zones[i]);
+  }
+
+  if (!rclock::transitions_cache_write(path_string, version_string, time_zones)) {
+    clock_abort("Can't write the zone cache to '%s'.", path_string.c_str());
   }
 }
 
@@ -41,6 +168,7 @@ cpp11::writable::strings zone_current() {
 
 
 const date::time_zone* zone_name_load_try(const std::string& zone_name);
+static bool zone_name_try_load_impl(const std::string& zone_name, const date::time_zone*& p_time_zone);
 
 // [[ include("zone.h") ]]
 const date::time_zone* zone_name_load(const std::string& zone_name) {
@@ -58,13 +186,49 @@ const date::time_zone* zone_name_load(const std::string& zone_name) {
 const date::time_zone* zone_name_load_try(const std::string& zone_name) {
   const date::time_zone* p_time_zone;
 
-  if (!tzdb::locate_zone(zone_name, p_time_zone)) {
+  if (!zone_name_try_load_impl(zone_name, p_time_zone)) {
     clock_abort("'%s' not found in the timezone database.", zone_name.c_str());
   }
 
   return p_time_zone;
 }
 
+// [[ include("zone.h") ]]
+bool zone_name_try_load(const std::string& zone_name, const date::time_zone*& p_time_zone) {
+  if (zone_name.size() == 0) {
+    std::string current_zone_name = zone_name_current();
+    return zone_name_try_load_impl(current_zone_name, p_time_zone);
+  } else {
+    return zone_name_try_load_impl(zone_name, p_time_zone);
+  }
+}
+
+static bool zone_name_try_load_impl(const std::string& zone_name, const date::time_zone*& p_time_zone) {
+  // Once per session, never cleared as `time_zone` pointers are stable. Keyed
+  // by name rather than by CHARSXP, as CHARSXPs can be garbage collected and
+  // their addresses reused.
+  static std::unordered_map<std::string, const date::time_zone*> cache;
+
+  auto it = cache.find(zone_name);
+
+  if (it != cache.end()) {
+    p_time_zone = it->second;
+    return true;
+  }
+
+  if (!tzdb::locate_zone(zone_name, p_time_zone)) {
+    return false;
+  }
+
+  // Materialize the zone's transition table up front, so per-element lookups
+  // never have to go back through `tzdb::`
+  rclock::get_transitions(p_time_zone);
+
+  cache.emplace(zone_name, p_time_zone);
+
+  return true;
+}
+
 static std::string zone_name_system();
 
 // [[ include("zone.h") ]]
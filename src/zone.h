@@ -3,6 +3,8 @@
 
 #include "clock.h"
 #include "utils.h"
+#include <string>
+#include <unordered_map>
 
 static
 inline
@@ -20,4 +22,87 @@ std::string zone_name_current();
  */
 const date::time_zone* zone_name_load(const std::string& zone_name);
 
+/*
+ * Load a time zone name, returning `false` if it can't be loaded
+ */
+bool zone_name_try_load(const std::string& zone_name, const date::time_zone*& p_time_zone);
+
+// -----------------------------------------------------------------------------
+
+namespace rclock {
+
+/*
+ * Per-call cache for loading the elements of a character vector of zone names.
+ *
+ * Keyed by the zone's CHARSXP, which is unique per string thanks to R's global
+ * CHARSXP cache, so each distinct zone is only resolved once per call. This is
+ * only safe for the lifetime of the vector that holds the CHARSXPs, which is
+ * why it isn't session wide. Invalid zones are cached as `NULL`.
+ */
+class zone_cache
+{
+  std::unordered_map<SEXP, const date::time_zone*> cache_;
+  SEXP last_;
+  const date::time_zone* p_last_;
+
+public:
+  zone_cache() noexcept;
+
+  const date::time_zone* load(SEXP zone_name);
+  bool try_load(SEXP zone_name, const date::time_zone*& p_time_zone);
+};
+
+inline
+zone_cache::zone_cache() noexcept
+  : last_(NULL),
+    p_last_(NULL)
+  {}
+
+/*
+ * Like `zone_name_load()`, throws an R error if the zone can't be loaded
+ */
+inline
+const date::time_zone*
+zone_cache::load(SEXP zone_name) {
+  const date::time_zone* p_time_zone;
+
+  if (!try_load(zone_name, p_time_zone)) {
+    // Let `zone_name_load()` throw the error
+    const std::string zone_name_string = cpp11::r_string(zone_name);
+    return zone_name_load(zone_name_string);
+  }
+
+  return p_time_zone;
+}
+
+inline
+bool
+zone_cache::try_load(SEXP zone_name, const date::time_zone*& p_time_zone) {
+  if (zone_name == last_) {
+    p_time_zone = p_last_;
+    return p_time_zone != NULL;
+  }
+
+  auto it = cache_.find(zone_name);
+
+  if (it == cache_.end()) {
+    const std::string zone_name_string = cpp11::r_string(zone_name);
+    const date::time_zone* p_elt = NULL;
+
+    if (!zone_name_try_load(zone_name_string, p_elt)) {
+      p_elt = NULL;
+    }
+
+    it = cache_.emplace(zone_name, p_elt).first;
+  }
+
+  last_ = zone_name;
+  p_last_ = it->second;
+
+  p_time_zone = p_last_;
+  return p_time_zone != NULL;
+}
+
+} // namespace rclock
+
 #endif
@@ -1,12 +1,20 @@
 #include "duration.h"
+#include "calendar.h"
+#include "gregorian-year-month-day.h"
 #include "enums.h"
 #include "utils.h"
 #include "get.h"
 #include "rcrd.h"
 #include "zone.h"
+#include "zone-cursor.h"
 #include "parse.h"
+#include "parse-program.h"
 #include "failure.h"
 #include "fill.h"
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 // -----------------------------------------------------------------------------
 
@@ -76,6 +84,34 @@ zoned_time_restore(SEXP x, SEXP to) {
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Fixed offset zones, like UTC, apply the same offset to every element and
+ * never need a lookup
+ */
+template <class ClockDuration>
+static
+inline
+cpp11::writable::list
+get_naive_time_fixed_impl(const ClockDuration& x,
+                          const std::chrono::seconds& offset) {
+  using Duration = typename ClockDuration::chrono_duration;
+
+  const r_ssize size = x.size();
+  ClockDuration out(size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (x.is_na(i)) {
+      out.assign_na(i);
+      continue;
+    }
+
+    const Duration elt = x[i];
+    out.assign(elt + offset, i);
+  }
+
+  return out.to_list();
+}
+
 template <class ClockDuration>
 static
 inline
@@ -87,47 +123,825 @@ get_naive_time_impl(cpp11::list_of<cpp11::doubles>& fields,
   const ClockDuration x{fields};
   const r_ssize size = x.size();
 
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+
+  if (table.is_fixed()) {
+    return get_naive_time_fixed_impl(x, table.fixed_offset());
+  }
+
+  ClockDuration out(size);
+
+  rclock::zone_cursor cursor{p_time_zone};
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (x.is_na(i)) {
+      out.assign_na(i);
+      continue;
+    }
+
+    const Duration elt = x[i];
+    const date::sys_time<Duration> elt_st{elt};
+    const date::local_time<Duration> elt_lt = cursor.get_local_time(elt_st);
+    const Duration elt_out = elt_lt.time_since_epoch();
+    out.assign(elt_out, i);
+  }
+
+  return out.to_list();
+}
+
+
+[[cpp11::register]]
+cpp11::writable::list
+get_naive_time_cpp(cpp11::list_of<cpp11::doubles> fields,
+                   const cpp11::integers& precision_int,
+                   const cpp11::strings& zone) {
+  using namespace rclock;
+
+  zone_size_validate(zone);
+  const std::string zone_name = cpp11::r_string(zone[0]);
+  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+
+  switch (parse_precision(precision_int)) {
+  case precision::second: return get_naive_time_impl<duration::seconds>(fields, p_time_zone);
+  case precision::millisecond: return get_naive_time_impl<duration::milliseconds>(fields, p_time_zone);
+  case precision::microsecond: return get_naive_time_impl<duration::microseconds>(fields, p_time_zone);
+  case precision::nanosecond: return get_naive_time_impl<duration::nanoseconds>(fields, p_time_zone);
+  default: clock_abort("Internal error: Should never be called.");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Resolves local times back to sys-times for the kernels below that modify a
+ * zoned-time in local time, one element at a time, without materializing the
+ * naive-times in between.
+ *
+ * `nonexistent` and `ambiguous` are either recycled or vectorized, and
+ * `reference_fields` holds the second precision sys-times used to resolve
+ * ambiguous times. It is empty when `ambiguous` is only made up of strings.
+ * The cursor is shared with the kernel, so local time lookups are reused
+ * across elements too.
+ */
+class zoned_local_resolver
+{
+  const date::time_zone* p_time_zone_;
+  const cpp11::strings& nonexistent_string_;
+  const cpp11::strings& ambiguous_string_;
+  const rclock::duration::seconds reference_;
+  const cpp11::sexp& call_;
+
+  const bool recycle_nonexistent_;
+  const bool recycle_ambiguous_;
+  const bool has_reference_;
+  const bool recycle_reference_;
+
+  enum nonexistent nonexistent_val_;
+  enum ambiguous ambiguous_val_;
+  date::sys_seconds reference_val_;
+
+  rclock::zone_cursor cursor_;
+
+public:
+  zoned_local_resolver(const date::time_zone* p_time_zone,
+                       const cpp11::strings& nonexistent_string,
+                       const cpp11::strings& ambiguous_string,
+                       cpp11::list_of<cpp11::doubles>& reference_fields,
+                       const cpp11::sexp& call);
+
+  bool recycled() const noexcept;
+  rclock::zone_cursor& cursor() noexcept;
+
+  template <class Duration, class ClockDuration>
+  void assign(const date::local_time<Duration>& lt, r_ssize i, ClockDuration& out);
+};
+
+inline
+zoned_local_resolver::zoned_local_resolver(const date::time_zone* p_time_zone,
+                                           const cpp11::strings& nonexistent_string,
+                                           const cpp11::strings& ambiguous_string,
+                                           cpp11::list_of<cpp11::doubles>& reference_fields,
+                                           const cpp11::sexp& call)
+  : p_time_zone_(p_time_zone),
+    nonexistent_string_(nonexistent_string),
+    ambiguous_string_(ambiguous_string),
+    reference_(reference_fields),
+    call_(call),
+    recycle_nonexistent_(clock_is_scalar(nonexistent_string)),
+    recycle_ambiguous_(clock_is_scalar(ambiguous_string)),
+    has_reference_(reference_.size() != 0),
+    recycle_reference_(reference_.size() == 1),
+    cursor_(p_time_zone) {
+  if (recycle_nonexistent_) {
+    nonexistent_val_ = parse_nonexistent_one(nonexistent_string_[0]);
+  }
+  if (recycle_ambiguous_) {
+    ambiguous_val_ = parse_ambiguous_one(ambiguous_string_[0]);
+  }
+  if (recycle_reference_) {
+    reference_val_ = date::sys_seconds{reference_[0]};
+  }
+}
+
+/*
+ * Are `nonexistent` and `ambiguous` recycled? Kernels can only skip resolving
+ * for fixed offset zones when they are, as vectorized options are still
+ * validated per element.
+ */
+inline
+bool
+zoned_local_resolver::recycled() const noexcept {
+  return recycle_nonexistent_ && recycle_ambiguous_;
+}
+
+inline
+rclock::zone_cursor&
+zoned_local_resolver::cursor() noexcept {
+  return cursor_;
+}
+
+// Resolve the `i`-th local time `lt` and assign it to `out`
+template <class Duration, class ClockDuration>
+inline
+void
+zoned_local_resolver::assign(const date::local_time<Duration>& lt, r_ssize i, ClockDuration& out) {
+  const enum nonexistent nonexistent_val =
+    recycle_nonexistent_ ?
+    nonexistent_val_ :
+    parse_nonexistent_one(nonexistent_string_[i]);
+
+  const enum ambiguous ambiguous_val =
+    recycle_ambiguous_ ?
+    ambiguous_val_ :
+    parse_ambiguous_one(ambiguous_string_[i]);
+
+  const date::local_info& info = cursor_.get_info(lt);
+
+  if (!has_reference_) {
+    out.convert_local_to_sys_and_assign(
+      lt,
+      info,
+      nonexistent_val,
+      ambiguous_val,
+      i,
+      call_
+    );
+    return;
+  }
+
+  const date::sys_seconds reference_val =
+    recycle_reference_ ?
+    reference_val_ :
+    date::sys_seconds{reference_[i]};
+
+  out.convert_local_with_reference_to_sys_and_assign(
+    lt,
+    info,
+    nonexistent_val,
+    ambiguous_val,
+    reference_val,
+    p_time_zone_,
+    i,
+    call_
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Rounding a zoned-time to a multiple of a local unit, like a local day. This
+ * is the same as:
+ *
+ * ```
+ * as_zoned_time(time_point_floor(as_naive_time(x), precision), zone)
+ * ```
+ *
+ * with each element resolved by a `zoned_local_resolver`.
+ *
+ * Every time point precision is an exact multiple of the precisions below it,
+ * so rounding to `n` units of `precision` is done as rounding to a `step` in
+ * units of `x`'s own precision. `origin` is a local time with the same
+ * precision as `x`, and is empty when there isn't one.
+ */
+
+enum class zoned_rounding {
+  floor,
+  ceil,
+  round,
+};
+
+template <class Rep>
+static
+inline
+Rep
+zoned_time_round_one(const Rep& x, const Rep& step, const enum zoned_rounding& type) {
+  const Rep floor = (x >= 0 ? x : (x - step + 1)) / step * step;
+
+  if (type == zoned_rounding::floor) {
+    return floor;
+  }
+
+  // Return input if on boundary
+  const Rep ceil = floor < x ? floor + step : floor;
+
+  if (type == zoned_rounding::ceil) {
+    return ceil;
+  }
+
+  // Round up on ties
+  return (ceil - x <= x - floor) ? ceil : floor;
+}
+
+template <class Duration>
+static
+inline
+typename Duration::rep
+zoned_time_rounding_step(const enum precision& precision_val, const int& n) {
+  using Rep = typename Duration::rep;
+
+  Rep unit;
+
+  switch (precision_val) {
+  case precision::week: unit = std::chrono::duration_cast<Duration>(date::weeks{1}).count(); break;
+  case precision::day: unit = std::chrono::duration_cast<Duration>(date::days{1}).count(); break;
+  case precision::hour: unit = std::chrono::duration_cast<Duration>(std::chrono::hours{1}).count(); break;
+  case precision::minute: unit = std::chrono::duration_cast<Duration>(std::chrono::minutes{1}).count(); break;
+  case precision::second: unit = std::chrono::duration_cast<Duration>(std::chrono::seconds{1}).count(); break;
+  case precision::millisecond: unit = std::chrono::duration_cast<Duration>(std::chrono::milliseconds{1}).count(); break;
+  case precision::microsecond: unit = std::chrono::duration_cast<Duration>(std::chrono::microseconds{1}).count(); break;
+  case precision::nanosecond: unit = std::chrono::duration_cast<Duration>(std::chrono::nanoseconds{1}).count(); break;
+  default: clock_abort("Internal error: Invalid rounding precision.");
+  }
+
+  if (unit < 1) {
+    clock_abort("Internal error: Can't round to a more precise precision.");
+  }
+  if (n < 1) {
+    clock_abort("Internal error: `n` must be positive.");
+  }
+  if (unit > std::numeric_limits<Rep>::max() / n) {
+    clock_abort("`n` is too large to round with.");
+  }
+
+  return unit * n;
+}
+
+template <class ClockDuration>
+static
+inline
+cpp11::writable::list
+zoned_time_rounding_impl(cpp11::list_of<cpp11::doubles>& fields,
+                         const date::time_zone* p_time_zone,
+                         const enum precision& precision_val,
+                         const int& n,
+                         cpp11::list_of<cpp11::doubles>& origin_fields,
+                         const enum zoned_rounding& type,
+                         const cpp11::strings& nonexistent_string,
+                         const cpp11::strings& ambiguous_string,
+                         cpp11::list_of<cpp11::doubles>& reference_fields,
+                         const cpp11::sexp& call) {
+  using Duration = typename ClockDuration::chrono_duration;
+  using Rep = typename Duration::rep;
+
+  const ClockDuration x{fields};
+  const ClockDuration origin{origin_fields};
+
+  const r_ssize size = x.size();
   ClockDuration out(size);
 
-  for (r_ssize i = 0; i < size; ++i) {
-    if (x.is_na(i)) {
-      out.assign_na(i);
-      continue;
+  const Rep step = zoned_time_rounding_step<Duration>(precision_val, n);
+  const Rep origin_val = origin.size() == 0 ? Rep{0} : origin[0].count();
+
+  zoned_local_resolver resolver{
+    p_time_zone,
+    nonexistent_string,
+    ambiguous_string,
+    reference_fields,
+    call
+  };
+
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+
+  // Only when recycled, as vectorized options are still validated per element
+  if (table.is_fixed() && resolver.recycled()) {
+    const Duration offset = table.fixed_offset();
+
+    for (r_ssize i = 0; i < size; ++i) {
+      if (x.is_na(i)) {
+        out.assign_na(i);
+        continue;
+      }
+
+      const Rep elt_local = (x[i] + offset).count() - origin_val;
+      const Duration elt_rounded{zoned_time_round_one(elt_local, step, type) + origin_val};
+
+      out.assign(elt_rounded - offset, i);
+    }
+
+    return out.to_list();
+  }
+
+  rclock::zone_cursor& cursor = resolver.cursor();
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (x.is_na(i)) {
+      out.assign_na(i);
+      continue;
+    }
+
+    const date::sys_time<Duration> elt_st{x[i]};
+    const date::local_time<Duration> elt_lt = cursor.get_local_time(elt_st);
+
+    const Rep elt_local = elt_lt.time_since_epoch().count() - origin_val;
+    const date::local_time<Duration> elt_rounded_lt{
+      Duration{zoned_time_round_one(elt_local, step, type) + origin_val}
+    };
+
+    resolver.assign(elt_rounded_lt, i, out);
+  }
+
+  return out.to_list();
+}
+
+static
+inline
+cpp11::writable::list
+zoned_time_rounding_switch(cpp11::list_of<cpp11::doubles>& fields,
+                           const cpp11::integers& precision_int,
+                           const cpp11::strings& zone,
+                           const cpp11::integers& precision_to_int,
+                           const int& n,
+                           cpp11::list_of<cpp11::doubles>& origin_fields,
+                           const enum zoned_rounding& type,
+                           const cpp11::strings& nonexistent_string,
+                           const cpp11::strings& ambiguous_string,
+                           cpp11::list_of<cpp11::doubles>& reference_fields,
+                           const cpp11::sexp& call) {
+  using namespace rclock;
+
+  zone_size_validate(zone);
+  const std::string zone_name = cpp11::r_string(zone[0]);
+  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+
+  const enum precision precision_to_val = parse_precision(precision_to_int);
+
+  switch (parse_precision(precision_int)) {
+  case precision::second: return zoned_time_rounding_impl<duration::seconds>(fields, p_time_zone, precision_to_val, n, origin_fields, type, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::millisecond: return zoned_time_rounding_impl<duration::milliseconds>(fields, p_time_zone, precision_to_val, n, origin_fields, type, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::microsecond: return zoned_time_rounding_impl<duration::microseconds>(fields, p_time_zone, precision_to_val, n, origin_fields, type, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::nanosecond: return zoned_time_rounding_impl<duration::nanoseconds>(fields, p_time_zone, precision_to_val, n, origin_fields, type, nonexistent_string, ambiguous_string, reference_fields, call);
+  default: clock_abort("Internal error: Should never be called.");
+  }
+}
+
+[[cpp11::register]]
+cpp11::writable::list
+zoned_time_floor_cpp(cpp11::list_of<cpp11::doubles> fields,
+                     const cpp11::integers& precision_int,
+                     const cpp11::strings& zone,
+                     const cpp11::integers& precision_to_int,
+                     const int& n,
+                     cpp11::list_of<cpp11::doubles> origin_fields,
+                     const cpp11::strings& nonexistent_string,
+                     const cpp11::strings& ambiguous_string,
+                     cpp11::list_of<cpp11::doubles> reference_fields,
+                     const cpp11::sexp& call) {
+  return zoned_time_rounding_switch(
+    fields,
+    precision_int,
+    zone,
+    precision_to_int,
+    n,
+    origin_fields,
+    zoned_rounding::floor,
+    nonexistent_string,
+    ambiguous_string,
+    reference_fields,
+    call
+  );
+}
+
+[[cpp11::register]]
+cpp11::writable::list
+zoned_time_ceiling_cpp(cpp11::list_of<cpp11::doubles> fields,
+                       const cpp11::integers& precision_int,
+                       const cpp11::strings& zone,
+                       const cpp11::integers& precision_to_int,
+                       const int& n,
+                       cpp11::list_of<cpp11::doubles> origin_fields,
+                       const cpp11::strings& nonexistent_string,
+                       const cpp11::strings& ambiguous_string,
+                       cpp11::list_of<cpp11::doubles> reference_fields,
+                       const cpp11::sexp& call) {
+  return zoned_time_rounding_switch(
+    fields,
+    precision_int,
+    zone,
+    precision_to_int,
+    n,
+    origin_fields,
+    zoned_rounding::ceil,
+    nonexistent_string,
+    ambiguous_string,
+    reference_fields,
+    call
+  );
+}
+
+[[cpp11::register]]
+cpp11::writable::list
+zoned_time_round_cpp(cpp11::list_of<cpp11::doubles> fields,
+                     const cpp11::integers& precision_int,
+                     const cpp11::strings& zone,
+                     const cpp11::integers& precision_to_int,
+                     const int& n,
+                     cpp11::list_of<cpp11::doubles> origin_fields,
+                     const cpp11::strings& nonexistent_string,
+                     const cpp11::strings& ambiguous_string,
+                     cpp11::list_of<cpp11::doubles> reference_fields,
+                     const cpp11::sexp& call) {
+  return zoned_time_rounding_switch(
+    fields,
+    precision_int,
+    zone,
+    precision_to_int,
+    n,
+    origin_fields,
+    zoned_rounding::round,
+    nonexistent_string,
+    ambiguous_string,
+    reference_fields,
+    call
+  );
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Adding local units, like days or weeks, to a zoned-time. This is the same as:
+ *
+ * ```
+ * as_zoned_time(as_naive_time(x) + n, zone)
+ * ```
+ *
+ * with each element resolved by a `zoned_local_resolver`. `n` is a duration
+ * with a precision of `precision_n_int`, which is always coarser than `x`'s
+ * precision.
+ */
+
+template <class ClockDuration, class ClockDurationN>
+static
+inline
+cpp11::writable::list
+zoned_time_plus_local_impl(cpp11::list_of<cpp11::doubles>& fields,
+                           const date::time_zone* p_time_zone,
+                           cpp11::list_of<cpp11::doubles>& n_fields,
+                           const cpp11::strings& nonexistent_string,
+                           const cpp11::strings& ambiguous_string,
+                           cpp11::list_of<cpp11::doubles>& reference_fields,
+                           const cpp11::sexp& call) {
+  using Duration = typename ClockDuration::chrono_duration;
+
+  const ClockDuration x{fields};
+  const ClockDurationN n{n_fields};
+
+  const r_ssize x_size = x.size();
+  const r_ssize n_size = n.size();
+
+  const bool recycle_x = x_size == 1;
+  const bool recycle_n = n_size == 1;
+
+  const r_ssize size = recycle_x ? n_size : x_size;
+
+  if (!recycle_n && n_size != size) {
+    clock_abort("Internal error: `x` and `n` should have been recycled to a common size.");
+  }
+
+  ClockDuration out(size);
+
+  zoned_local_resolver resolver{
+    p_time_zone,
+    nonexistent_string,
+    ambiguous_string,
+    reference_fields,
+    call
+  };
+
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+
+  // With a fixed offset, adding in local time is the same as adding in sys time
+  if (table.is_fixed() && resolver.recycled()) {
+    for (r_ssize i = 0; i < size; ++i) {
+      const r_ssize i_x = recycle_x ? 0 : i;
+      const r_ssize i_n = recycle_n ? 0 : i;
+
+      if (x.is_na(i_x) || n.is_na(i_n)) {
+        out.assign_na(i);
+        continue;
+      }
+
+      out.assign(x[i_x] + n[i_n], i);
+    }
+
+    return out.to_list();
+  }
+
+  rclock::zone_cursor& cursor = resolver.cursor();
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const r_ssize i_x = recycle_x ? 0 : i;
+    const r_ssize i_n = recycle_n ? 0 : i;
+
+    if (x.is_na(i_x) || n.is_na(i_n)) {
+      out.assign_na(i);
+      continue;
+    }
+
+    const date::sys_time<Duration> elt_st{x[i_x]};
+    const date::local_time<Duration> elt_lt = cursor.get_local_time(elt_st) + n[i_n];
+
+    resolver.assign(elt_lt, i, out);
+  }
+
+  return out.to_list();
+}
+
+template <class ClockDurationN>
+static
+inline
+cpp11::writable::list
+zoned_time_plus_local_switch(cpp11::list_of<cpp11::doubles>& fields,
+                             const enum precision& precision_val,
+                             const date::time_zone* p_time_zone,
+                             cpp11::list_of<cpp11::doubles>& n_fields,
+                             const cpp11::strings& nonexistent_string,
+                             const cpp11::strings& ambiguous_string,
+                             cpp11::list_of<cpp11::doubles>& reference_fields,
+                             const cpp11::sexp& call) {
+  using namespace rclock;
+
+  switch (precision_val) {
+  case precision::second: return zoned_time_plus_local_impl<duration::seconds, ClockDurationN>(fields, p_time_zone, n_fields, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::millisecond: return zoned_time_plus_local_impl<duration::milliseconds, ClockDurationN>(fields, p_time_zone, n_fields, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::microsecond: return zoned_time_plus_local_impl<duration::microseconds, ClockDurationN>(fields, p_time_zone, n_fields, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::nanosecond: return zoned_time_plus_local_impl<duration::nanoseconds, ClockDurationN>(fields, p_time_zone, n_fields, nonexistent_string, ambiguous_string, reference_fields, call);
+  default: clock_abort("Internal error: Should never be called.");
+  }
+}
+
+[[cpp11::register]]
+cpp11::writable::list
+zoned_time_plus_local_cpp(cpp11::list_of<cpp11::doubles> fields,
+                          const cpp11::integers& precision_int,
+                          const cpp11::strings& zone,
+                          cpp11::list_of<cpp11::doubles> n_fields,
+                          const cpp11::integers& precision_n_int,
+                          const cpp11::strings& nonexistent_string,
+                          const cpp11::strings& ambiguous_string,
+                          cpp11::list_of<cpp11::doubles> reference_fields,
+                          const cpp11::sexp& call) {
+  using namespace rclock;
+
+  zone_size_validate(zone);
+  const std::string zone_name = cpp11::r_string(zone[0]);
+  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+
+  const enum precision precision_val = parse_precision(precision_int);
+
+  switch (parse_precision(precision_n_int)) {
+  case precision::week: return zoned_time_plus_local_switch<duration::weeks>(fields, precision_val, p_time_zone, n_fields, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::day: return zoned_time_plus_local_switch<duration::days>(fields, precision_val, p_time_zone, n_fields, nonexistent_string, ambiguous_string, reference_fields, call);
+  default: clock_abort("Internal error: Should never be called.");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
+/*
+ * Setting a local year-month-day component of a zoned-time. This is the same
+ * as:
+ *
+ * ```
+ * x <- set_*(as_year_month_day(as_naive_time(x)), value)
+ * x <- invalid_resolve(x, invalid = invalid)
+ * as_zoned_time(as_naive_time(x), zone)
+ * ```
+ *
+ * with each element resolved by a `zoned_local_resolver`. Invalid dates can
+ * only come from setting the year, month, or day, and are resolved inline with
+ * the same rules as `invalid_resolve()`. With `last`, the day is set to the
+ * last day of the month and `value` is ignored.
+ */
+
+template <class ClockDuration>
+static
+inline
+cpp11::writable::list
+zoned_time_set_local_impl(cpp11::list_of<cpp11::doubles>& fields,
+                          const date::time_zone* p_time_zone,
+                          const cpp11::integers& value,
+                          const enum component& component_val,
+                          const bool& last,
+                          const enum invalid& invalid_val,
+                          const cpp11::strings& nonexistent_string,
+                          const cpp11::strings& ambiguous_string,
+                          cpp11::list_of<cpp11::doubles>& reference_fields,
+                          const cpp11::sexp& call) {
+  using Duration = typename ClockDuration::chrono_duration;
+  using namespace rclock::gregorian;
+
+  const ClockDuration x{fields};
+  const rclock::integers v{value};
+
+  const r_ssize x_size = x.size();
+  const r_ssize v_size = v.size();
+
+  const bool recycle_x = !last && x_size == 1;
+  const bool recycle_v = v_size == 1;
+
+  const r_ssize size = recycle_x ? v_size : x_size;
+
+  if (!last && !recycle_v && v_size != size) {
+    clock_abort("Internal error: `x` and `value` should have been recycled to a common size.");
+  }
+
+  ClockDuration out(size);
+
+  zoned_local_resolver resolver{
+    p_time_zone,
+    nonexistent_string,
+    ambiguous_string,
+    reference_fields,
+    call
+  };
+
+  rclock::zone_cursor& cursor = resolver.cursor();
+
+  for (r_ssize i = 0; i < size; ++i) {
+    const r_ssize i_x = recycle_x ? 0 : i;
+    const r_ssize i_v = recycle_v ? 0 : i;
+
+    if (x.is_na(i_x) || (!last && v.is_na(i_v))) {
+      out.assign_na(i);
+      continue;
+    }
+
+    const int elt_v = last ? 0 : v[i_v];
+
+    const date::sys_time<Duration> elt_st{x[i_x]};
+    const date::local_time<Duration> elt_lt = cursor.get_local_time(elt_st);
+    const date::local_days elt_ld = date::floor<date::days>(elt_lt);
+
+    date::year_month_day elt_ymd{elt_ld};
+    Duration elt_tod = elt_lt - elt_ld;
+
+    switch (component_val) {
+    case component::year: {
+      elt_ymd = date::year{elt_v} / elt_ymd.month() / elt_ymd.day();
+      break;
+    }
+    case component::month: {
+      elt_ymd = elt_ymd.year() / date::month{static_cast<unsigned>(elt_v)} / elt_ymd.day();
+      break;
+    }
+    case component::day: {
+      if (last) {
+        elt_ymd = date::year_month_day{elt_ymd.year() / elt_ymd.month() / date::last};
+      } else {
+        elt_ymd = elt_ymd.year() / elt_ymd.month() / date::day{static_cast<unsigned>(elt_v)};
+      }
+      break;
+    }
+    case component::hour: {
+      const std::chrono::hours elt_hours = date::floor<std::chrono::hours>(elt_tod);
+      elt_tod += std::chrono::hours{elt_v} - elt_hours;
+      break;
+    }
+    case component::minute: {
+      const std::chrono::hours elt_hours = date::floor<std::chrono::hours>(elt_tod);
+      const std::chrono::minutes elt_minutes = date::floor<std::chrono::minutes>(elt_tod) - elt_hours;
+      elt_tod += std::chrono::minutes{elt_v} - elt_minutes;
+      break;
+    }
+    case component::second: {
+      const std::chrono::minutes elt_minutes = date::floor<std::chrono::minutes>(elt_tod);
+      const std::chrono::seconds elt_seconds = date::floor<std::chrono::seconds>(elt_tod) - elt_minutes;
+      elt_tod += std::chrono::seconds{elt_v} - elt_seconds;
+      break;
+    }
+    default: {
+      clock_abort("Internal error: Unsupported `component`.");
+    }
+    }
+
+    if (!elt_ymd.ok()) {
+      switch (invalid_val) {
+      case invalid::next: {
+        elt_ymd = detail::resolve_next_day_ymd(elt_ymd);
+        elt_tod = Duration::zero();
+        break;
+      }
+      case invalid::next_day: {
+        elt_ymd = detail::resolve_next_day_ymd(elt_ymd);
+        break;
+      }
+      case invalid::previous: {
+        elt_ymd = detail::resolve_previous_day_ymd(elt_ymd);
+        elt_tod = date::days{1} - Duration{1};
+        break;
+      }
+      case invalid::previous_day: {
+        elt_ymd = detail::resolve_previous_day_ymd(elt_ymd);
+        break;
+      }
+      case invalid::overflow: {
+        elt_ymd = date::year_month_day{date::sys_days{elt_ymd}};
+        elt_tod = Duration::zero();
+        break;
+      }
+      case invalid::overflow_day: {
+        elt_ymd = date::year_month_day{date::sys_days{elt_ymd}};
+        break;
+      }
+      case invalid::na: {
+        out.assign_na(i);
+        continue;
+      }
+      case invalid::error: {
+        rclock::detail::resolve_error(i, call);
+      }
+      }
     }
 
-    const Duration elt = x[i];
-    const date::sys_time<Duration> elt_st{elt};
-    const date::local_time<Duration> elt_lt = rclock::get_local_time(elt_st, p_time_zone);
-    const Duration elt_out = elt_lt.time_since_epoch();
-    out.assign(elt_out, i);
+    const date::local_time<Duration> elt_out_lt = date::local_days{elt_ymd} + elt_tod;
+
+    resolver.assign(elt_out_lt, i, out);
   }
 
   return out.to_list();
 }
 
-
 [[cpp11::register]]
 cpp11::writable::list
-get_naive_time_cpp(cpp11::list_of<cpp11::doubles> fields,
-                   const cpp11::integers& precision_int,
-                   const cpp11::strings& zone) {
+zoned_time_set_local_cpp(cpp11::list_of<cpp11::doubles> fields,
+                         const cpp11::integers& precision_int,
+                         const cpp11::strings& zone,
+                         const cpp11::integers& value,
+                         const cpp11::strings& component,
+                         const bool& last,
+                         const cpp11::strings& invalid_string,
+                         const cpp11::strings& nonexistent_string,
+                         const cpp11::strings& ambiguous_string,
+                         cpp11::list_of<cpp11::doubles> reference_fields,
+                         const cpp11::sexp& call) {
   using namespace rclock;
 
   zone_size_validate(zone);
   const std::string zone_name = cpp11::r_string(zone[0]);
   const date::time_zone* p_time_zone = zone_name_load(zone_name);
 
+  const enum component component_val = parse_component(component);
+  const enum invalid invalid_val = parse_invalid(invalid_string);
+
   switch (parse_precision(precision_int)) {
-  case precision::second: return get_naive_time_impl<duration::seconds>(fields, p_time_zone);
-  case precision::millisecond: return get_naive_time_impl<duration::milliseconds>(fields, p_time_zone);
-  case precision::microsecond: return get_naive_time_impl<duration::microseconds>(fields, p_time_zone);
-  case precision::nanosecond: return get_naive_time_impl<duration::nanoseconds>(fields, p_time_zone);
+  case precision::second: return zoned_time_set_local_impl<duration::seconds>(fields, p_time_zone, value, component_val, last, invalid_val, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::millisecond: return zoned_time_set_local_impl<duration::milliseconds>(fields, p_time_zone, value, component_val, last, invalid_val, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::microsecond: return zoned_time_set_local_impl<duration::microseconds>(fields, p_time_zone, value, component_val, last, invalid_val, nonexistent_string, ambiguous_string, reference_fields, call);
+  case precision::nanosecond: return zoned_time_set_local_impl<duration::nanoseconds>(fields, p_time_zone, value, component_val, last, invalid_val, nonexistent_string, ambiguous_string, reference_fields, call);
   default: clock_abort("Internal error: Should never be called.");
   }
 }
 
 // -----------------------------------------------------------------------------
 
+/*
+ * With a fixed offset zone every local time is unique, so `nonexistent` and
+ * `ambiguous` never come into play
+ */
+template <class ClockDuration>
+static
+inline
+cpp11::writable::list
+as_zoned_sys_time_from_naive_time_fixed_impl(const ClockDuration& x,
+                                             const std::chrono::seconds& offset) {
+  using Duration = typename ClockDuration::chrono_duration;
+
+  const r_ssize size = x.size();
+  ClockDuration out(size);
+
+  for (r_ssize i = 0; i < size; ++i) {
+    if (x.is_na(i)) {
+      out.assign_na(i);
+      continue;
+    }
+
+    const Duration elt = x[i];
+    out.assign(elt - offset, i);
+  }
+
+  return out.to_list();
+}
+
 template <class ClockDuration>
 static
 inline
@@ -156,25 +970,24 @@ as_zoned_sys_time_from_naive_time_impl(cpp11::list_of<cpp11::doubles>& fields,
     ambiguous_val = parse_ambiguous_one(ambiguous_string[0]);
   }
 
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+
+  // Only when recycled, as vectorized options are still validated per element
+  if (table.is_fixed() && recycle_nonexistent && recycle_ambiguous) {
+    return as_zoned_sys_time_from_naive_time_fixed_impl(x, table.fixed_offset());
+  }
+
+  rclock::zone_cursor cursor{p_time_zone};
+
   for (r_ssize i = 0; i < size; ++i) {
     if (x.is_na(i)) {
       out.assign_na(i);
       continue;
     }
 
-    const enum nonexistent elt_nonexistent_val =
-      recycle_nonexistent ?
-      nonexistent_val :
-      parse_nonexistent_one(nonexistent_string[i]);
-
-    const enum ambiguous elt_ambiguous_val =
-      recycle_ambiguous ?
-      ambiguous_val :
-      parse_ambiguous_one(ambiguous_string[i]);
-
     const Duration elt = x[i];
     const date::local_time<Duration> elt_lt{elt};
-    const date::local_info elt_info = rclock::get_info(elt_lt, p_time_zone);
+    const date::local_info& elt_info = cursor.get_info(elt_lt);
 
     out.convert_local_to_sys_and_assign(
       elt_lt,
@@ -248,22 +1061,21 @@ as_zoned_sys_time_from_naive_time_with_reference_impl(cpp11::list_of<cpp11::doub
     reference_val = date::sys_seconds{reference[0]};
   }
 
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+
+  // Only when recycled, as vectorized options are still validated per element
+  if (table.is_fixed() && recycle_nonexistent && recycle_ambiguous) {
+    return as_zoned_sys_time_from_naive_time_fixed_impl(x, table.fixed_offset());
+  }
+
+  rclock::zone_cursor cursor{p_time_zone};
+
   for (r_ssize i = 0; i < size; ++i) {
     if (x.is_na(i)) {
       out.assign_na(i);
       continue;
     }
 
-    const enum nonexistent elt_nonexistent_val =
-      recycle_nonexistent ?
-      nonexistent_val :
-      parse_nonexistent_one(nonexistent_string[i]);
-
-    const enum ambiguous elt_ambiguous_val =
-      recycle_ambiguous ?
-      ambiguous_val :
-      parse_ambiguous_one(ambiguous_string[i]);
-
     const date::sys_seconds elt_reference_val =
       recycle_reference ?
       reference_val :
@@ -271,7 +1083,7 @@ as_zoned_sys_time_from_naive_time_with_reference_impl(cpp11::list_of<cpp11::doub
 
     const Duration elt = x[i];
     const date::local_time<Duration> elt_lt{elt};
-    const date::local_info elt_info = rclock::get_info(elt_lt, p_time_zone);
+    const date::local_info& elt_info = cursor.get_info(elt_lt);
 
     out.convert_local_with_reference_to_sys_and_assign(
       elt_lt,
@@ -316,6 +1128,239 @@ as_zoned_sys_time_from_naive_time_with_reference_cpp(cpp11::list_of<cpp11::doubl
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Would resolving a local time with `info` signal an error?
+ */
+static
+inline
+bool
+local_info_is_error(const date::local_info& info,
+                    const enum nonexistent& nonexistent_val,
+                    const enum ambiguous& ambiguous_val) {
+  switch (info.result) {
+  case date::local_info::nonexistent: return nonexistent_val == nonexistent::error;
+  case date::local_info::ambiguous: return ambiguous_val == ambiguous::error;
+  default: return false;
+  }
+}
+
+/*
+ * Converting naive-times to sys-times with a time zone per element, like a
+ * column of zone names in a data frame.
+ *
+ * Resolving the elements in their original order would reset the cursor every
+ * time the zone changes, throwing away its cached lookups, so the elements are
+ * first grouped by zone with a counting sort. Each group is then resolved with
+ * a single `time_zone*`, keeping the original order of its elements, and
+ * written back to their original locations. A single zone is one group that
+ * doesn't need to be sorted at all.
+ *
+ * With more than one group, elements that would error are skipped until every
+ * group has been resolved, so the error is reported for the smallest failing
+ * location rather than the first one in group order.
+ */
+template <class ClockDuration>
+static
+inline
+cpp11::writable::list
+as_sys_time_from_naive_time_zones_impl(cpp11::list_of<cpp11::doubles>& fields,
+                                       const cpp11::strings& zone,
+                                       const cpp11::strings& nonexistent_string,
+                                       const cpp11::strings& ambiguous_string,
+                                       const cpp11::sexp& call) {
+  using Duration = typename ClockDuration::chrono_duration;
+
+  const ClockDuration x{fields};
+  const r_ssize size = x.size();
+  ClockDuration out(size);
+
+  const bool recycle_zone = zone.size() == 1;
+  const bool recycle_nonexistent = clock_is_scalar(nonexistent_string);
+  const bool recycle_ambiguous = clock_is_scalar(ambiguous_string);
+
+  enum nonexistent nonexistent_val;
+  enum ambiguous ambiguous_val;
+
+  if (recycle_nonexistent) {
+    nonexistent_val = parse_nonexistent_one(nonexistent_string[0]);
+  }
+  if (recycle_ambiguous) {
+    ambiguous_val = parse_ambiguous_one(ambiguous_string[0]);
+  }
+
+  // Zone of each group, in order of first appearance
+  std::vector<const date::time_zone*> group_zones;
+  std::vector<r_ssize> group_sizes;
+
+  // Group of each element, only needed with more than one zone
+  std::vector<r_ssize> groups;
+
+  if (recycle_zone) {
+    const std::string zone_name = cpp11::r_string(zone[0]);
+    group_zones.push_back(zone_name_load(zone_name));
+    group_sizes.push_back(size);
+  } else {
+    groups.resize(size);
+
+    rclock::zone_cache cache;
+    std::unordered_map<const date::time_zone*, r_ssize> ids;
+
+    const date::time_zone* p_time_zone_last = NULL;
+    r_ssize id_last = -1;
+
+    for (r_ssize i = 0; i < size; ++i) {
+      const date::time_zone* p_time_zone_elt = cache.load(zone[i]);
+
+      if (p_time_zone_elt != p_time_zone_last) {
+        auto it = ids.find(p_time_zone_elt);
+
+        if (it == ids.end()) {
+          it = ids.emplace(p_time_zone_elt, static_cast<r_ssize>(group_zones.size())).first;
+          group_zones.push_back(p_time_zone_elt);
+          group_sizes.push_back(0);
+        }
+
+        p_time_zone_last = p_time_zone_elt;
+        id_last = it->second;
+      }
+
+      groups[i] = id_last;
+      ++group_sizes[id_last];
+    }
+  }
+
+  const r_ssize n_groups = static_cast<r_ssize>(group_zones.size());
+  const bool sorted = n_groups > 1;
+
+  // `group_starts[g]` is the location of the first element of group `g` in `order`
+  std::vector<r_ssize> group_starts(n_groups + 1, 0);
+  for (r_ssize g = 0; g < n_groups; ++g) {
+    group_starts[g + 1] = group_starts[g] + group_sizes[g];
+  }
+
+  std::vector<r_ssize> order;
+
+  if (sorted) {
+    order.resize(size);
+    std::vector<r_ssize> locs(group_starts.begin(), group_starts.end() - 1);
+
+    for (r_ssize i = 0; i < size; ++i) {
+      order[locs[groups[i]]++] = i;
+    }
+  }
+
+  rclock::zone_cursor cursor{NULL};
+
+  // Smallest location that failed to resolve, or `size` if there wasn't one
+  r_ssize failure = size;
+
+  for (r_ssize g = 0; g < n_groups; ++g) {
+    const date::time_zone* p_time_zone = group_zones[g];
+    const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+
+    // Only when recycled, as vectorized options are still validated per element
+    const bool fixed = table.is_fixed() && recycle_nonexistent && recycle_ambiguous;
+    const Duration offset = fixed ? Duration{table.fixed_offset()} : Duration::zero();
+
+    cursor.reset(p_time_zone);
+
+    for (r_ssize k = group_starts[g]; k < group_starts[g + 1]; ++k) {
+      const r_ssize i = sorted ? order[k] : k;
+
+      if (x.is_na(i)) {
+        out.assign_na(i);
+        continue;
+      }
+
+      const Duration elt = x[i];
+
+      if (fixed) {
+        out.assign(elt - offset, i);
+        continue;
+      }
+
+      const enum nonexistent elt_nonexistent_val =
+        recycle_nonexistent ?
+        nonexistent_val :
+        parse_nonexistent_one(nonexistent_string[i]);
+
+      const enum ambiguous elt_ambiguous_val =
+        recycle_ambiguous ?
+        ambiguous_val :
+        parse_ambiguous_one(ambiguous_string[i]);
+
+      const date::local_time<Duration> elt_lt{elt};
+      const date::local_info& elt_info = cursor.get_info(elt_lt);
+
+      if (sorted && local_info_is_error(elt_info, elt_nonexistent_val, elt_ambiguous_val)) {
+        failure = std::min(failure, i);
+        continue;
+      }
+
+      out.convert_local_to_sys_and_assign(
+        elt_lt,
+        elt_info,
+        elt_nonexistent_val,
+        elt_ambiguous_val,
+        i,
+        call
+      );
+    }
+  }
+
+  if (failure != size) {
+    // Resolve the failure again, this time letting it signal its error
+    const r_ssize i = failure;
+
+    const enum nonexistent elt_nonexistent_val =
+      recycle_nonexistent ?
+      nonexistent_val :
+      parse_nonexistent_one(nonexistent_string[i]);
+
+    const enum ambiguous elt_ambiguous_val =
+      recycle_ambiguous ?
+      ambiguous_val :
+      parse_ambiguous_one(ambiguous_string[i]);
+
+    cursor.reset(group_zones[groups[i]]);
+
+    const date::local_time<Duration> elt_lt{x[i]};
+    const date::local_info& elt_info = cursor.get_info(elt_lt);
+
+    out.convert_local_to_sys_and_assign(
+      elt_lt,
+      elt_info,
+      elt_nonexistent_val,
+      elt_ambiguous_val,
+      i,
+      call
+    );
+  }
+
+  return out.to_list();
+}
+
+[[cpp11::register]]
+cpp11::writable::list
+as_sys_time_from_naive_time_zones_cpp(cpp11::list_of<cpp11::doubles> fields,
+                                      const cpp11::integers& precision_int,
+                                      const cpp11::strings& zone,
+                                      const cpp11::strings& nonexistent_string,
+                                      const cpp11::strings& ambiguous_string,
+                                      const cpp11::sexp& call) {
+  using namespace rclock;
+
+  switch (parse_precision(precision_int)) {
+  case precision::second: return as_sys_time_from_naive_time_zones_impl<duration::seconds>(fields, zone, nonexistent_string, ambiguous_string, call);
+  case precision::millisecond: return as_sys_time_from_naive_time_zones_impl<duration::milliseconds>(fields, zone, nonexistent_string, ambiguous_string, call);
+  case precision::microsecond: return as_sys_time_from_naive_time_zones_impl<duration::microseconds>(fields, zone, nonexistent_string, ambiguous_string, call);
+  case precision::nanosecond: return as_sys_time_from_naive_time_zones_impl<duration::nanoseconds>(fields, zone, nonexistent_string, ambiguous_string, call);
+  default: clock_abort("Internal error: Should never be called.");
+  }
+}
+
+// -----------------------------------------------------------------------------
+
 [[cpp11::register]]
 cpp11::writable::list
 to_sys_duration_fields_from_sys_seconds_cpp(const cpp11::doubles& seconds) {
@@ -368,6 +1413,73 @@ to_sys_seconds_from_sys_duration_fields_cpp(cpp11::list_of<cpp11::doubles> field
 
 // -----------------------------------------------------------------------------
 
+/*
+ * Getters for POSIXct, fused into a single pass from seconds since the epoch
+ * to one component in local time. This gives the same result as
+ * `get_*(as_year_month_day(as_naive_time(as_zoned_time(x))))`, but skips the
+ * intermediate sys-time, naive-time, and calendar, and only allocates the
+ * output, see `get_ymd_component_block()`.
+ */
+[[cpp11::register]]
+cpp11::writable::integers
+get_posixt_component_cpp(const cpp11::doubles& x,
+                         const cpp11::strings& zone,
+                         const cpp11::strings& component) {
+  using rclock::duration::block_size;
+  using rclock::duration::block_na;
+
+  zone_size_validate(zone);
+  const std::string zone_name = cpp11::r_string(zone[0]);
+  const date::time_zone* p_time_zone = zone_name_load(zone_name);
+
+  const enum component component_val = parse_component(component);
+
+  const rclock::transitions& table = rclock::get_transitions(p_time_zone);
+  const bool fixed = table.is_fixed();
+  const std::chrono::seconds offset = fixed ? table.fixed_offset() : std::chrono::seconds{0};
+
+  rclock::zone_cursor cursor{p_time_zone};
+
+  const r_ssize size = x.size();
+  const double* p_x = REAL_RO(x);
+
+  cpp11::writable::integers out(size);
+  int* p_out = INTEGER(out);
+
+  // Local seconds, a block at a time
+  int64_t block[block_size];
+
+  for (r_ssize start = 0; start < size; start += block_size) {
+    const r_ssize n = std::min(block_size, size - start);
+
+    for (r_ssize k = 0; k < n; ++k) {
+      // Assume seconds precision!
+      const double elt_seconds = p_x[start + k];
+
+      if (r_dbl_is_missing(elt_seconds) || clock_dbl_is_oob_for_int64(elt_seconds)) {
+        block[k] = block_na;
+        continue;
+      }
+
+      const std::chrono::seconds elt{clock_dbl_as_int64(elt_seconds)};
+
+      if (fixed) {
+        block[k] = static_cast<int64_t>((elt + offset).count());
+      } else {
+        const date::sys_seconds elt_st{elt};
+        const date::local_seconds elt_lt = cursor.get_local_time(elt_st);
+        block[k] = static_cast<int64_t>(elt_lt.time_since_epoch().count());
+      }
+    }
+
+    get_ymd_component_block<std::chrono::seconds>(block, n, component_val, p_out + start);
+  }
+
+  return out;
+}
+
+// -----------------------------------------------------------------------------
+
 static
 inline
 void
@@ -401,50 +1513,32 @@ template <class ClockDuration>
 static
 inline
 void
-zoned_time_parse_complete_one(std::istringstream& stream,
-                              const std::vector<std::string>& fmts,
-                              const std::pair<const std::string*, const std::string*>& month_names_pair,
-                              const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                              const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                              const char& dmark,
+zoned_time_parse_complete_one(rclock::parse_stream& stream,
+                              const char* p_elt,
+                              rclock::parse_programs& programs,
                               const r_ssize& i,
                               rclock::failures& fail,
                               std::string& zone,
                               const date::time_zone*& p_time_zone,
+                              rclock::zone_cursor& cursor,
                               ClockDuration& fields) {
   using Duration = typename ClockDuration::chrono_duration;
   static const std::chrono::minutes not_an_offset = std::chrono::minutes::min();
 
-  const r_ssize size = fmts.size();
-
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
-
-    const char* fmt = fmts[j].c_str();
+  const r_ssize n_programs = programs.size();
 
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::local_time<Duration> lt;
     std::string new_zone;
     std::chrono::minutes offset{not_an_offset};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
-      lt,
-      &new_zone,
-      &offset
-    );
-
-    if (stream.fail()) {
+    if (!programs[k].parse(stream, p_elt, lt, &new_zone, &offset)) {
       continue;
     }
 
     if (p_time_zone == NULL) {
       finalize_parse_zone(new_zone, zone, p_time_zone);
+      cursor.reset(p_time_zone);
     } else if (new_zone != zone) {
       stop_heterogeneous_zones(zone, new_zone);
     }
@@ -453,7 +1547,7 @@ zoned_time_parse_complete_one(std::istringstream& stream,
       clock_abort("`%%z` must be used, and must result in a valid offset from UTC.");
     }
 
-    const date::local_info info = rclock::get_info(lt, p_time_zone);
+    const date::local_info& info = cursor.get_info(lt);
 
     switch (info.result) {
     case date::local_info::nonexistent: {
@@ -479,6 +1573,7 @@ zoned_time_parse_complete_one(std::istringstream& stream,
     }
 
     fields.assign(lt.time_since_epoch() - offset, i);
+    programs.hit(k);
     return;
   }
 
@@ -529,12 +1624,21 @@ zoned_time_parse_complete_impl(const cpp11::strings& x,
     ampm_names
   );
 
+  rclock::parse_programs programs(
+    fmts,
+    month_names_pair,
+    weekday_names_pair,
+    ampm_names_pair,
+    dmark
+  );
+
   rclock::failures fail{};
 
   std::string zone;
   const date::time_zone* p_time_zone = NULL;
+  rclock::zone_cursor cursor{p_time_zone};
 
-  std::istringstream stream;
+  rclock::parse_stream stream;
 
   void* vmax = vmaxget();
 
@@ -548,29 +1652,28 @@ zoned_time_parse_complete_impl(const cpp11::strings& x,
 
     const char* p_elt = Rf_translateCharUTF8(elt);
 
-    stream.str(p_elt);
-
     zoned_time_parse_complete_one(
       stream,
-      fmts,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
+      p_elt,
+      programs,
       i,
       fail,
       zone,
       p_time_zone,
+      cursor,
       fields
     );
-  }
 
-  vmaxset(vmax);
+    // Release the translation of `elt`, if it needed one
+    vmaxset(vmax);
+  }
 
   if (fail.any_failures()) {
     fail.warn_parse();
   }
 
+  programs.signal_hits();
+
   if (zone.empty()) {
     // In the case of all failures, all NAs, or empty input, there will
     // be no way to determine a time zone.
@@ -617,45 +1720,25 @@ template <class ClockDuration>
 static
 inline
 void
-zoned_time_parse_abbrev_one(std::istringstream& stream,
-                            const std::vector<std::string>& fmts,
-                            const std::pair<const std::string*, const std::string*>& month_names_pair,
-                            const std::pair<const std::string*, const std::string*>& weekday_names_pair,
-                            const std::pair<const std::string*, const std::string*>& ampm_names_pair,
-                            const char& dmark,
+zoned_time_parse_abbrev_one(rclock::parse_stream& stream,
+                            const char* p_elt,
+                            rclock::parse_programs& programs,
                             const r_ssize& i,
                             rclock::failures& fail,
-                            const date::time_zone*& p_time_zone,
+                            rclock::zone_cursor& cursor,
                             ClockDuration& fields) {
   using Duration = typename ClockDuration::chrono_duration;
 
-  const r_ssize size = fmts.size();
-
-  for (r_ssize j = 0; j < size; ++j) {
-    stream.clear();
-    stream.seekg(0);
-
-    const char* fmt = fmts[j].c_str();
+  const r_ssize n_programs = programs.size();
 
+  for (r_ssize k = 0; k < n_programs; ++k) {
     date::local_time<Duration> lt;
     std::string parsed_abbrev;
 
     // Parsed, but ignored
     std::chrono::minutes parsed_offset{};
 
-    rclock::from_stream(
-      stream,
-      fmt,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
-      lt,
-      &parsed_abbrev,
-      &parsed_offset
-    );
-
-    if (stream.fail()) {
+    if (!programs[k].parse(stream, p_elt, lt, &parsed_abbrev, &parsed_offset)) {
       continue;
     }
 
@@ -663,7 +1746,7 @@ zoned_time_parse_abbrev_one(std::istringstream& stream,
       clock_abort("`%%Z` must be used and must result in a time zone abbreviation.");
     }
 
-    const date::local_info info = rclock::get_info(lt, p_time_zone);
+    const date::local_info& info = cursor.get_info(lt);
     std::chrono::seconds offset{};
 
     switch (info.result) {
@@ -695,6 +1778,7 @@ zoned_time_parse_abbrev_one(std::istringstream& stream,
     }
 
     fields.assign(lt.time_since_epoch() - offset, i);
+    programs.hit(k);
     return;
   }
 
@@ -746,9 +1830,18 @@ zoned_time_parse_abbrev_impl(const cpp11::strings& x,
     ampm_names
   );
 
+  rclock::parse_programs programs(
+    fmts,
+    month_names_pair,
+    weekday_names_pair,
+    ampm_names_pair,
+    dmark
+  );
+
   rclock::failures fail{};
+  rclock::zone_cursor cursor{p_time_zone};
 
-  std::istringstream stream;
+  rclock::parse_stream stream;
 
   void* vmax = vmaxget();
 
@@ -762,28 +1855,26 @@ zoned_time_parse_abbrev_impl(const cpp11::strings& x,
 
     const char* p_elt = Rf_translateCharUTF8(elt);
 
-    stream.str(p_elt);
-
     zoned_time_parse_abbrev_one(
       stream,
-      fmts,
-      month_names_pair,
-      weekday_names_pair,
-      ampm_names_pair,
-      dmark,
+      p_elt,
+      programs,
       i,
       fail,
-      p_time_zone,
+      cursor,
       fields
     );
-  }
 
-  vmaxset(vmax);
+    // Release the translation of `elt`, if it needed one
+    vmaxset(vmax);
+  }
 
   if (fail.any_failures()) {
     fail.warn_parse();
   }
 
+  programs.signal_hits();
+
   return fields.to_list();
 }
 